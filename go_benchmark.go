@@ -1,7 +1,9 @@
 //   go run go_benchmark.go -Ns 10000,100000,1000000 -reps 3 -seed 42 -outfile go-results.csv
+//   go run go_benchmark.go -replay-trace streams/MIXED_R50W50_N100000_seed42.ipbt -outfile go-results.csv
 package main
 
 import (
+	"encoding/binary"
 	"encoding/csv"
 	"flag"
 	"fmt"
@@ -65,7 +67,7 @@ func runScenario(arr Array, scenario string, N int, seed int64) (ops int, totalN
 		start := time.Now()
 		arr.Init(42)
 		el := time.Since(start).Nanoseconds()
-		return 1, el, 0, el
+		return 1, el, float64(el), el
 	case "READ_UNWRITTEN":
 		arr.Init(123)
 		M := min(1000000, 10*N)
@@ -123,6 +125,51 @@ func runScenario(arr Array, scenario string, N int, seed int64) (ops int, totalN
 	}
 }
 
+// Canonical stream files emitted by the C++ harness (--emit-streams): IPBT
+// v1, 24-byte header then 16-byte (op_index, value) records; the op lives in
+// the top 2 bits of op_index (0=read, 1=write, 2=init), the index in the
+// low 62.
+const traceIndexMask = (uint64(1) << 62) - 1
+
+type traceOp struct {
+	opIndex uint64
+	value   int64
+}
+
+func loadTrace(path string) (int, []traceOp) {
+	data, err := os.ReadFile(path)
+	if err != nil { panic(err) }
+	if len(data) < 24 || string(data[:4]) != "IPBT" || binary.LittleEndian.Uint32(data[4:8]) != 1 {
+		panic("not a v1 trace file: " + path)
+	}
+	n := int(binary.LittleEndian.Uint64(data[8:16]))
+	count := int(binary.LittleEndian.Uint64(data[16:24]))
+	if len(data) < 24+16*count { panic("trace file truncated: " + path) }
+	ops := make([]traceOp, count)
+	for i := 0; i < count; i++ {
+		off := 24 + 16*i
+		ops[i] = traceOp{binary.LittleEndian.Uint64(data[off : off+8]), int64(binary.LittleEndian.Uint64(data[off+8 : off+16]))}
+	}
+	return n, ops
+}
+
+func runTrace(arr Array, ops []traceOp) (int, int64, float64, int64) {
+	start := time.Now()
+	var s int64 = 0
+	for _, op := range ops {
+		idx := int(op.opIndex & traceIndexMask)
+		switch op.opIndex >> 62 {
+		case 0: s ^= arr.Read(idx)
+		case 1: arr.Write(idx, op.value)
+		default: arr.Init(op.value)
+		}
+	}
+	el := time.Since(start).Nanoseconds()
+	consume(s)
+	m := len(ops)
+	return m, el, float64(el) / float64(m), 0
+}
+
 func parseSizes(s string) []int {
 	parts := strings.Split(s, ",")
 	var out []int
@@ -145,6 +192,7 @@ func main() {
 	repsFlag := flag.Int("reps", 3, "repetitions")
 	seedFlag := flag.Int64("seed", 42, "seed")
 	outFlag := flag.String("outfile", "go-results.csv", "output csv")
+	replayFlag := flag.String("replay-trace", "", "replay a canonical .ipbt stream from the C++ harness")
 	flag.Parse()
 
 	out, err := os.Create(*outFlag)
@@ -164,12 +212,28 @@ func main() {
 		"ADVERSARIAL_HOTSPOT",
 	}
 
+	var traceOps []traceOp
+	if *replayFlag != "" {
+		var traceN int
+		traceN, traceOps = loadTrace(*replayFlag)
+		fmt.Printf("Replaying %d ops (trace N=%d) from %s\n", len(traceOps), traceN, *replayFlag)
+		Nlist = []int{traceN}
+		scenarios = []string{"TRACE_REPLAY"}
+	}
+
 	for _, N := range Nlist {
 		for _, scenario := range scenarios {
 			for _, seed := range seeds {
 				for rep := 1; rep <= reps; rep++ {
 					arr := NewSliceImpl(N)
-					ops, tot, nspop, initns := runScenario(arr, scenario, N, seed)
+					var ops int
+					var tot, initns int64
+					var nspop float64
+					if traceOps != nil {
+						ops, tot, nspop, initns = runTrace(arr, traceOps)
+					} else {
+						ops, tot, nspop, initns = runScenario(arr, scenario, N, seed)
+					}
 					record := []string{
 						nowISO(), arr.Name(), scenario,
 						fmt.Sprintf("%d", N), fmt.Sprintf("%d", seed), fmt.Sprintf("%d", rep),
@@ -12,6 +12,18 @@
 #include <ctime>
 #include <algorithm>
 #include <sstream>
+#include <thread>
+#include <atomic>
+#include <cmath>
+
+#if defined(__linux__)
+#  include <linux/perf_event.h>
+#  include <sys/ioctl.h>
+#  include <sys/syscall.h>
+#  include <sys/stat.h>
+#  include <fcntl.h>
+#  include <unistd.h>
+#endif
 
 static std::vector<size_t> parse_sizes(const std::string& s) {
     std::vector<size_t> out;
@@ -34,11 +46,23 @@ static std::vector<size_t> parse_sizes(const std::string& s) {
 }
 static void print_usage() {
     std::cout << "Usage:\n"
-              << "  benchmark --verify <sec3|sec4> [N] [seed]\n"
+              << "  benchmark --verify <sec3|sec4> [N] [seed] [--verify-ops 1000]\n"
               << "  benchmark [--Ns 10000,100000,1000000] [--reps 3] [--seed 42] [--impls std_vector,sec3,sec4,std_vector_direct]\n"
-              << "            [--outfile results.csv]\n";
+              << "            [--dispatch virtual|static|both] [--latency-hist] [--threads 1,2,4|sweep]\n"
+              << "            [--alloc malloc|hugepage] [--numa interleave|bind:<node>] [--perf]\n"
+              << "            [--hotspot-frac 0.1] [--hotspot-pct 50]\n"
+              << "            [--warmup 1] [--max-rci 0.05] [--max-samples 10]\n"
+              << "            [--record-trace file [--trace-scenario MIXED_R90W10]] [--replay-trace file]\n"
+              << "            [--workload file]  (phased lifecycle: 'phase <label> ops= reads= dist=' / 'init [v]')\n"
+              << "            [--emit-streams dir]  (write canonical .ipbt streams for every traceable scenario x N)\n"
+              << "            [--conform results.csv]  (validate another harness's CSV schema and op counts)\n"
+              << "            [--find-breakeven [--breakeven-impl sec4] [--breakeven-scenario WRITE_RANDOM]]\n"
+              << "            [--outfile results.csv] [--format csv|bin]\n"
+              << "  benchmark --convert-results results.bin results.csv\n";
 }
 
+int g_verify_ops = 1000;  // campaign length; override with --verify-ops
+
 void verify_correctness(const std::string& impl_name, size_t N, unsigned int seed) {
     std::cout << "\n--- Running Correctness Verification for " << impl_name 
               << " with N=" << N << " seed=" << seed << " ---\n";
@@ -57,6 +81,54 @@ void verify_correctness(const std::string& impl_name, size_t N, unsigned int see
             auto impl = std::make_unique<InPlaceArraySec4>(N);
             impl->enable_verification();
             dut = std::move(impl);
+        } else if (impl_name == "sec3_i32") {
+            auto impl = std::make_unique<InPlaceArraySec3T<std::int32_t>>(N);
+            impl->enable_verification();
+            dut = std::move(impl);
+        } else if (impl_name == "sec4_i32") {
+            auto impl = std::make_unique<InPlaceArraySec4T<std::int32_t>>(N);
+            impl->enable_verification();
+            dut = std::move(impl);
+        } else if (impl_name == "sec3_i16") {
+            auto impl = std::make_unique<InPlaceArraySec3T<std::int16_t>>(N);
+            impl->enable_verification();
+            dut = std::move(impl);
+        } else if (impl_name == "sec4_i16") {
+            auto impl = std::make_unique<InPlaceArraySec4T<std::int16_t>>(N);
+            impl->enable_verification();
+            dut = std::move(impl);
+        } else if (impl_name == "sec4_c32") {
+            auto impl = std::make_unique<InPlaceArraySec4C32>(N);
+            impl->enable_verification();
+            dut = std::move(impl);
+        } else if (impl_name == "sec4_bf") {
+            auto impl = std::make_unique<InPlaceArraySec4BF>(N);
+            impl->enable_verification();
+            dut = std::move(impl);
+        } else if (impl_name == "blk8") {
+            auto impl = std::make_unique<InPlaceArrayBlocked<8>>(N);
+            impl->enable_verification();
+            dut = std::move(impl);
+        } else if (impl_name == "blk16") {
+            auto impl = std::make_unique<InPlaceArrayBlocked<16>>(N);
+            impl->enable_verification();
+            dut = std::move(impl);
+        } else if (impl_name == "epoch_stamp") {
+            auto impl = std::make_unique<EpochStampArray>(N);
+            impl->enable_verification();
+            dut = std::move(impl);
+        } else if (impl_name == "bitmap") {
+            auto impl = std::make_unique<BitmapArray>(N);
+            impl->enable_verification();
+            dut = std::move(impl);
+        } else if (impl_name == "adaptive") {
+            auto impl = std::make_unique<AdaptiveInitArray>(N);
+            impl->enable_verification();
+            dut = std::move(impl);
+        } else if (impl_name == "concurrent") {
+            auto impl = std::make_unique<ConcurrentInPlaceArray>(N);
+            impl->enable_verification();
+            dut = std::move(impl);
         } else {
             std::cerr << "Unknown impl for verification: " << impl_name << std::endl;
             return;
@@ -70,38 +142,88 @@ void verify_correctness(const std::string& impl_name, size_t N, unsigned int see
     std::uniform_int_distribution<long long> value_dist(-1000, 1000);
     std::uniform_int_distribution<size_t> index_dist(0, N-1);
     
-    const int num_operations = 1000;
+    const int num_operations = g_verify_ops;
+    // Long campaigns would be quadratic with a full shadow scan per check, so
+    // interleave cheap sampled checks (touched indices + random spot checks)
+    // and leave the exhaustive scan for the end.
+    const int check_every = std::max(1, num_operations / 10);
     bool passed = true;
-    
+
     try {
         for (int op = 0; op < num_operations && passed; op++) {
-            int op_type = rng() % 3;
-            
-            if (op_type == 0) {  
+            if (op > 0 && op % check_every == 0 &&
+                !dut->verify_correctness_sampled(1000, seed + (unsigned)op)) {
+                std::cerr << "Sampled verification failed after " << op << " operations" << std::endl;
+                passed = false;
+                break;
+            }
+            int op_type = rng() % 6;
+
+            if (op_type == 0) {
                 long long init_val = value_dist(rng);
                 reference->init(init_val);
                 dut->init(init_val);
-                
-            } else if (op_type == 1) {  
+
+            } else if (op_type == 1) {
                 size_t idx = index_dist(rng);
                 long long ref_val = reference->read(idx);
                 long long dut_val = dut->read(idx);
-                
+
                 if (ref_val != dut_val) {
-                    std::cerr << "MISMATCH at read(" << idx << "): reference=" 
+                    std::cerr << "MISMATCH at read(" << idx << "): reference="
                               << ref_val << ", " << impl_name << "=" << dut_val << std::endl;
                     dut->dump_state_on_failure(idx);
                     passed = false;
                 }
-                
-            } else {  
+
+            } else if (op_type == 2) {
                 size_t idx = index_dist(rng);
                 long long val = value_dist(rng);
                 reference->write(idx, val);
                 dut->write(idx, val);
+            } else if (op_type == 3) {
+                size_t lo = index_dist(rng);
+                size_t hi = std::min(N, lo + 1 + rng() % 64);
+                std::vector<long long> src(hi - lo);
+                for (auto& x : src) x = value_dist(rng);
+                reference->write_range(lo, hi, src.data());
+                dut->write_range(lo, hi, src.data());
+            } else if (op_type == 4) {
+                size_t lo = index_dist(rng);
+                size_t hi = std::min(N, lo + 1 + rng() % 64);
+                std::vector<long long> ref_vals(hi - lo), dut_vals(hi - lo);
+                reference->read_range(lo, hi, ref_vals.data());
+                dut->read_range(lo, hi, dut_vals.data());
+                if (ref_vals != dut_vals) {
+                    std::cerr << "MISMATCH in read_range(" << lo << "," << hi << ")" << std::endl;
+                    dut->dump_state_on_failure(lo);
+                    passed = false;
+                }
+            } else {
+                size_t lo = index_dist(rng);
+                size_t hi = std::min(N, lo + 1 + rng() % 64);
+                long long val = value_dist(rng);
+                reference->init_range(lo, hi, val);
+                dut->init_range(lo, hi, val);
             }
         }
         
+        // The aggregate kernels must agree with the reference at any fill
+        // level, including runs that straddle chained and settled blocks.
+        if (passed) {
+            size_t lo = index_dist(rng);
+            size_t hi = std::min(N, lo + 1 + rng() % 4096);
+            for (auto [l, h] : { std::pair<size_t,size_t>{lo, hi}, {0, N} }) {
+                if (dut->sum_range(l, h)   != reference->sum_range(l, h) ||
+                    dut->min_range(l, h)   != reference->min_range(l, h) ||
+                    dut->count_eq(l, h, 0) != reference->count_eq(l, h, 0)) {
+                    std::cerr << "MISMATCH in aggregate over [" << l << "," << h << ")" << std::endl;
+                    passed = false;
+                    break;
+                }
+            }
+        }
+
         if (passed && !dut->verify_correctness()) {
             passed = false;
         }
@@ -124,6 +246,383 @@ struct Config {
     size_t N;
     unsigned int seed;
     int rep_id;
+    size_t prefetch_dist = 8;
+    bool latency_hist = false;
+    std::string alloc = "malloc";
+    double hotspot_frac = 0.10;   // ADVERSARIAL_HOTSPOT: hot region as a fraction of N
+    int hotspot_pct = 50;         // ADVERSARIAL_HOTSPOT: % of ops landing in the hot region
+};
+
+// The in-place impls take the backing allocation policy as a constructor
+// argument; impls without a tunable backing store ignore it.
+AllocMode alloc_mode_of(const Config& config) {
+    return config.alloc == "hugepage" ? AllocMode::HugePage : AllocMode::Malloc;
+}
+
+// Zipfian rank sampler (Gray et al.), theta in (0,1): O(1) per sample after
+// a one-time zeta(N) pass. The zeta sum is cached per (N,theta) for the
+// whole process so repeated reps/impls at the same N do not pay it again.
+// Rank 0 is the hottest index; ranks map to indices directly, giving the
+// same front-of-array hot region as ADVERSARIAL_HOTSPOT.
+struct ZipfianSampler {
+    size_t n; double theta, alpha, zeta2, eta, zetan;
+    ZipfianSampler(size_t n_, double theta_) : n(n_), theta(theta_) {
+        if (!(theta > 0.0 && theta < 1.0))
+            throw std::invalid_argument("ZIPF_<theta> requires 0 < theta < 1");
+        static std::map<std::pair<size_t,double>, double> zeta_cache;
+        static std::mutex zeta_mtx;
+        std::lock_guard<std::mutex> lk(zeta_mtx);
+        auto it = zeta_cache.find({n, theta});
+        if (it == zeta_cache.end()) {
+            double z = 0.0;
+            for (size_t i = 1; i <= n; ++i) z += 1.0 / std::pow((double)i, theta);
+            it = zeta_cache.emplace(std::make_pair(n, theta), z).first;
+        }
+        zetan = it->second;
+        zeta2 = 1.0 + 1.0 / std::pow(2.0, theta);
+        alpha = 1.0 / (1.0 - theta);
+        eta = (1.0 - std::pow(2.0/(double)n, 1.0-theta)) / (1.0 - zeta2/zetan);
+    }
+    size_t operator()(std::mt19937& rng) {
+        double u = ((double)rng() + 0.5) / 4294967296.0;
+        double uz = u * zetan;
+        if (uz < 1.0) return 0;
+        if (uz < zeta2) return 1;
+        size_t r = (size_t)((double)n * std::pow(eta*u - eta + 1.0, alpha));
+        return r < n ? r : n - 1;
+    }
+};
+
+// Binary trace format (--record-trace / --replay-trace): a 24-byte header
+// followed by 16-byte records. The op lives in the top 2 bits of op_index
+// (0=read, 1=write, 2=init) and the index in the low 62, so replay is one
+// mask and one shift per op -- no parsing. The same file can be replayed
+// bit-identically across impls and by the other language harnesses.
+struct TraceRecord { uint64_t op_index; long long value; };
+struct TraceHeader { char magic[4]; uint32_t version; uint64_t N; uint64_t count; };
+constexpr uint64_t kTraceIndexMask = (1ULL << 62) - 1;
+constexpr int kTraceOpShift = 62;
+enum : uint64_t { kTraceRead = 0, kTraceWrite = 1, kTraceInit = 2 };
+
+const TraceRecord* g_trace_data = nullptr;
+size_t g_trace_count = 0;
+size_t g_trace_N = 0;
+
+// Reproduces the op stream a scenario would issue (including the leading
+// init), using the same distributions and draw order as run_scenario_direct.
+std::vector<TraceRecord> generate_trace(const std::string& scenario, size_t N,
+                                        unsigned seed, double hotspot_frac, int hotspot_pct) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<size_t> index_dist(0, N - 1);
+    std::uniform_int_distribution<long long> value_dist(-1000, 1000);
+    std::vector<TraceRecord> out;
+    auto rec = [&](uint64_t op, size_t idx, long long v) {
+        out.push_back({(op << kTraceOpShift) | (uint64_t)idx, v});
+    };
+    if (scenario == "READ_UNWRITTEN") {
+        rec(kTraceInit, 0, 123);
+        size_t M = std::min((size_t)1e6, 10 * N);
+        for (size_t i = 0; i < M; ++i) rec(kTraceRead, index_dist(rng), 0);
+    } else if (scenario == "WRITE_RANDOM") {
+        rec(kTraceInit, 0, 0);
+        size_t M = std::min((size_t)1e6, N);
+        for (size_t i = 0; i < M; ++i) rec(kTraceWrite, index_dist(rng), value_dist(rng));
+    } else if (scenario == "ADVERSARIAL_HOTSPOT") {
+        rec(kTraceInit, 0, 0);
+        size_t M = std::min((size_t)1e6, N);
+        size_t hotspot_size = std::max((size_t)1, (size_t)((double)N * hotspot_frac));
+        for (size_t i = 0; i < M; ++i) {
+            size_t idx = (rng()%100 < (unsigned)hotspot_pct) ? (rng()%hotspot_size) : index_dist(rng);
+            rec(kTraceWrite, idx, value_dist(rng));
+        }
+    } else if (scenario.rfind("ZIPF_",0)==0) {
+        rec(kTraceInit, 0, 0);
+        ZipfianSampler zipf(N, std::stod(scenario.substr(5)));
+        size_t M = std::min((size_t)1e6, N);
+        for (size_t i = 0; i < M; ++i) rec(kTraceWrite, zipf(rng), value_dist(rng));
+    } else if (scenario.rfind("MIXED_",0)==0 && scenario!="MIXED_SATURATED") {
+        std::string perc = scenario.substr(6);
+        size_t rpos = perc.find('R'), wpos = perc.find('W');
+        int read_pct = std::stoi(perc.substr(rpos+1, wpos-rpos-1));
+        rec(kTraceInit, 0, 42);
+        size_t M = std::min((size_t)1e6, N);
+        for (size_t i = 0; i < M; ++i) {
+            size_t idx = index_dist(rng);
+            if (rng()%100 < (unsigned)read_pct) rec(kTraceRead, idx, 0);
+            else rec(kTraceWrite, idx, value_dist(rng));
+        }
+    } else {
+        throw std::invalid_argument("scenario not traceable: " + scenario);
+    }
+    return out;
+}
+
+void write_trace(const std::string& path, size_t N, const std::vector<TraceRecord>& ops) {
+    std::ofstream f(path, std::ios::binary);
+    if (!f.is_open()) throw std::runtime_error("cannot open trace file: " + path);
+    TraceHeader hdr{{'I','P','B','T'}, 1u, (uint64_t)N, (uint64_t)ops.size()};
+    f.write(reinterpret_cast<const char*>(&hdr), sizeof hdr);
+    f.write(reinterpret_cast<const char*>(ops.data()), (std::streamsize)(ops.size()*sizeof(TraceRecord)));
+    if (!f) throw std::runtime_error("short write to trace file: " + path);
+}
+
+// Maps the trace read-only so multi-million-op files cost no parse time and
+// no copy; the non-Linux fallback reads it into a heap buffer instead.
+void load_trace(const std::string& path) {
+    const TraceRecord* data = nullptr;
+    TraceHeader hdr{};
+#if defined(__linux__)
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) throw std::runtime_error("cannot open trace file: " + path);
+    struct stat st{};
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(TraceHeader)) {
+        close(fd); throw std::runtime_error("trace file truncated: " + path);
+    }
+    void* m = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (m == MAP_FAILED) throw std::runtime_error("cannot mmap trace file: " + path);
+    hdr = *reinterpret_cast<const TraceHeader*>(m);
+    if ((size_t)st.st_size < sizeof(TraceHeader) + hdr.count*sizeof(TraceRecord))
+        throw std::runtime_error("trace file truncated: " + path);
+    data = reinterpret_cast<const TraceRecord*>(static_cast<const char*>(m) + sizeof(TraceHeader));
+#else
+    std::ifstream f(path, std::ios::binary);
+    if (!f.is_open()) throw std::runtime_error("cannot open trace file: " + path);
+    f.read(reinterpret_cast<char*>(&hdr), sizeof hdr);
+    static std::vector<TraceRecord> buf;
+    buf.resize(hdr.count);
+    f.read(reinterpret_cast<char*>(buf.data()), (std::streamsize)(hdr.count*sizeof(TraceRecord)));
+    if (!f) throw std::runtime_error("trace file truncated: " + path);
+    data = buf.data();
+#endif
+    if (std::string(hdr.magic, 4) != "IPBT" || hdr.version != 1u)
+        throw std::runtime_error("not a v1 trace file: " + path);
+    g_trace_data = data;
+    g_trace_count = (size_t)hdr.count;
+    g_trace_N = (size_t)hdr.N;
+}
+
+// Workload files (--workload): compose a phased lifecycle as one scenario.
+// Plain text, one directive per line, '#' starts a comment:
+//   phase <label> ops=<count> reads=<pct> dist=<seq|uniform|zipf:<theta>>
+//   init [<value>]
+// Phases run back to back on one live instance (see WORKLOAD in
+// run_scenario_direct), and each directive becomes its own labeled CSV row.
+struct WorkloadPhase {
+    std::string label;
+    size_t ops = 0;
+    int read_pct = 0;
+    std::string dist = "uniform";   // "seq", "uniform" or "zipf"
+    double zipf_theta = 0.99;
+    bool is_init = false;
+    long long init_value = 0;
+};
+std::vector<WorkloadPhase> g_workload;
+
+void load_workload(const std::string& path) {
+    std::ifstream f(path);
+    if (!f.is_open()) throw std::runtime_error("cannot open workload file: " + path);
+    std::vector<WorkloadPhase> phases;
+    std::string line;
+    int lineno = 0, inits = 0;
+    while (std::getline(f, line)) {
+        ++lineno;
+        auto hash = line.find('#');
+        if (hash != std::string::npos) line.erase(hash);
+        std::stringstream ss(line);
+        std::string tok;
+        if (!(ss >> tok)) continue;
+        auto bad = [&](const std::string& what) {
+            throw std::runtime_error(path + ":" + std::to_string(lineno) + ": " + what);
+        };
+        if (tok == "init") {
+            WorkloadPhase p;
+            p.is_init = true;
+            // Number repeated resets so their rows stay distinguishable.
+            p.label = ++inits == 1 ? "INIT" : "INIT" + std::to_string(inits);
+            long long v;
+            if (ss >> v) p.init_value = v;
+            phases.push_back(p);
+        } else if (tok == "phase") {
+            WorkloadPhase p;
+            if (!(ss >> p.label)) bad("phase needs a label");
+            bool have_ops = false;
+            std::string kv;
+            while (ss >> kv) {
+                auto eq = kv.find('=');
+                if (eq == std::string::npos) bad("expected key=value, got '" + kv + "'");
+                std::string key = kv.substr(0, eq), val = kv.substr(eq + 1);
+                if (key == "ops") { p.ops = std::stoull(val); have_ops = true; }
+                else if (key == "reads") { p.read_pct = std::stoi(val); }
+                else if (key == "dist") {
+                    if (val == "seq" || val == "uniform") p.dist = val;
+                    else if (val.rfind("zipf:", 0) == 0) { p.dist = "zipf"; p.zipf_theta = std::stod(val.substr(5)); }
+                    else bad("unknown dist '" + val + "'");
+                } else bad("unknown key '" + key + "'");
+            }
+            if (!have_ops || p.ops == 0) bad("phase needs ops=<count> > 0");
+            if (p.read_pct < 0 || p.read_pct > 100) bad("reads must be 0..100");
+            phases.push_back(p);
+        } else {
+            bad("unknown directive '" + tok + "'");
+        }
+    }
+    if (phases.empty()) throw std::runtime_error(path + ": no phases");
+    g_workload = std::move(phases);
+}
+
+// Pregenerates every phase's index/op stream so the timed region is nothing
+// but back-to-back phases -- sampling cost stays out of the loop, and no
+// untimed gap disturbs cache state between transitions. Sequential phases
+// share one cursor so a later seq phase resumes where the previous left off.
+struct WorkloadStream { std::vector<size_t> idx; std::vector<uint8_t> is_read; };
+std::vector<WorkloadStream> build_workload_streams(size_t N, std::mt19937& rng) {
+    std::uniform_int_distribution<size_t> index_dist(0, N - 1);
+    std::vector<WorkloadStream> streams(g_workload.size());
+    size_t seq_pos = 0;
+    for (size_t p = 0; p < g_workload.size(); ++p) {
+        const auto& ph = g_workload[p];
+        if (ph.is_init) continue;
+        auto& st = streams[p];
+        st.idx.resize(ph.ops);
+        st.is_read.resize(ph.ops);
+        std::unique_ptr<ZipfianSampler> zipf;
+        if (ph.dist == "zipf") zipf.reset(new ZipfianSampler(N, ph.zipf_theta));
+        for (size_t i = 0; i < ph.ops; ++i) {
+            st.idx[i] = ph.dist == "seq" ? (seq_pos++ % N)
+                      : zipf             ? (*zipf)(rng)
+                                         : index_dist(rng);
+            st.is_read[i] = (uint8_t)(rng() % 100 < (unsigned)ph.read_pct);
+        }
+    }
+    return streams;
+}
+
+// HDR-style log-linear histogram: 16 linear sub-buckets per power of two,
+// allocated up front so recording is two loads and two stores per sample.
+struct LatencyHistogram {
+    static constexpr size_t kBuckets = 1024;
+    std::vector<uint64_t> counts;
+    uint64_t max_ns = 0;
+    uint64_t total = 0;
+    LatencyHistogram() : counts(kBuckets, 0) {}
+
+    static size_t bucket_of(uint64_t ns) {
+        if (ns < 16) return (size_t)ns;
+        int msb = 4; uint64_t v = ns >> 5;
+        while (v) { ++msb; v >>= 1; }
+        return (size_t)(msb - 3) * 16 + (size_t)((ns >> (msb - 4)) & 15);
+    }
+    // Lower edge of a bucket; the resolution error is < 1/16 of the value.
+    static uint64_t value_of(size_t bk) {
+        if (bk < 16) return (uint64_t)bk;
+        int msb = (int)(bk / 16) + 3;
+        uint64_t mant = bk % 16;
+        return (1ULL << msb) | (mant << (msb - 4));
+    }
+    void record(uint64_t ns) {
+        ++counts[bucket_of(ns)];
+        ++total;
+        if (ns > max_ns) max_ns = ns;
+    }
+    uint64_t percentile(double p) const {
+        if (total == 0) return 0;
+        uint64_t target = (uint64_t)(p * (double)total + 0.5);
+        if (target < 1) target = 1;
+        uint64_t seen = 0;
+        for (size_t bk = 0; bk < kBuckets; ++bk) {
+            seen += counts[bk];
+            if (seen >= target) return value_of(bk);
+        }
+        return max_ns;
+    }
+};
+
+// Hardware counters sampled around the timed region of each scenario,
+// enabled with --perf. The windows deliberately match the logical-counter
+// windows: untimed prefill phases are excluded, so LLC/dTLB/branch misses
+// can be correlated with the relocation counts the same row reports.
+struct PerfEvents {
+    unsigned long long llc_misses = 0;
+    unsigned long long dtlb_misses = 0;
+    unsigned long long branch_misses = 0;
+    unsigned long long instructions = 0;
+};
+bool g_perf_requested = false;
+
+#if defined(__linux__)
+// One fd per event, opened lazily per thread (pid=0, any cpu) so threaded
+// runs attribute events to the worker that caused them. Events that fail to
+// open (perf_event_paranoid, missing PMU) report 0 after a one-time warning.
+class PerfGroup {
+public:
+    ~PerfGroup() { for (int fd : fds) if (fd >= 0) close(fd); }
+    void begin() {
+        if (!opened) { open_all(); opened = true; }
+        for (int fd : fds) if (fd >= 0) {
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+    void end(PerfEvents& out) {
+        for (int fd : fds) if (fd >= 0) ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        out.llc_misses    = read_one(0);
+        out.dtlb_misses   = read_one(1);
+        out.branch_misses = read_one(2);
+        out.instructions  = read_one(3);
+    }
+private:
+    void open_all() {
+        fds[0] = open_event(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+        fds[1] = open_event(PERF_TYPE_HW_CACHE,
+                            PERF_COUNT_HW_CACHE_DTLB
+                          | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+                          | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16));
+        fds[2] = open_event(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+        fds[3] = open_event(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+        static std::atomic<bool> warned{false};
+        if ((fds[0]<0 || fds[1]<0 || fds[2]<0 || fds[3]<0) && !warned.exchange(true))
+            std::cerr << "warning: some perf events unavailable "
+                         "(check /proc/sys/kernel/perf_event_paranoid); "
+                         "missing columns report 0\n";
+    }
+    static int open_event(unsigned type, unsigned long long cfg) {
+        perf_event_attr attr{};
+        attr.size = sizeof(attr);
+        attr.type = type;
+        attr.config = cfg;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+    }
+    unsigned long long read_one(int i) {
+        if (fds[i] < 0) return 0;
+        unsigned long long v = 0;
+        if (read(fds[i], &v, sizeof v) != (ssize_t)sizeof v) return 0;
+        return v;
+    }
+    int fds[4] = {-1,-1,-1,-1};
+    bool opened = false;
+};
+thread_local PerfGroup t_perf;
+void perf_begin() { if (g_perf_requested) t_perf.begin(); }
+void perf_end(PerfEvents& out) { if (g_perf_requested) t_perf.end(out); }
+#else
+void perf_begin() {}
+void perf_end(PerfEvents&) {}
+#endif
+
+// One FILL_SWEEP checkpoint: progress of the fill and the cost paid so far.
+// Each becomes its own CSV row so the amortization curve is plottable.
+struct FillCheckpoint {
+    size_t writes_done;
+    long long elapsed_ns;
+    Counters counters;
+    size_t written_blocks;
+    // Empty for FILL_SWEEP rows; multi-phase scenarios (CHECKPOINT_RESTORE)
+    // put the phase name here and it replaces the scenario in the CSV row.
+    std::string label;
 };
 
 struct Result {
@@ -138,6 +637,21 @@ struct Result {
     double ns_per_op = 0.0;
     long long init_time_ns = 0;
     Counters counters;
+    std::string dispatch = "virtual";
+    LatencyHistogram hist;
+    bool hist_recorded = false;
+    size_t threads = 1;
+    std::string alloc = "malloc";
+    PerfEvents perf;
+    size_t written_blocks = 0;
+    std::string numa = "none";
+    std::vector<FillCheckpoint> fill_checkpoints;
+    // Robust aggregates over the adaptive samples of one row (ns_per_op is
+    // their mean); single-sample paths report min=median=mean, mad=0.
+    double min_ns_per_op = 0.0;
+    double median_ns_per_op = 0.0;
+    double mad_ns_per_op = 0.0;
+    size_t samples = 1;
 };
 
 std::string get_current_timestamp() {
@@ -148,10 +662,13 @@ std::string get_current_timestamp() {
 }
 
 void write_csv_header(std::ofstream& file) {
-    file << "timestamp_iso,impl_name,scenario,N,seed,rep_id,ops_in_run,total_time_ns,ns_per_op,init_time_ns_if_recorded,relocations_count,conversions_count\n";
+    file << "timestamp_iso,impl_name,scenario,N,seed,rep_id,ops_in_run,total_time_ns,ns_per_op,init_time_ns_if_recorded,relocations_count,conversions_count,dispatch,p50_ns,p90_ns,p99_ns,p999_ns,max_ns,threads,agg_mops,alloc,llc_misses,dtlb_misses,branch_misses,instructions,written_blocks,min_ns_per_op,median_ns_per_op,mad_ns_per_op,samples,scan_gbps,numa\n";
 }
 
-void write_csv_row(std::ofstream& file, const Result& res) {
+// Row formatting with the latency percentiles passed in explicitly, so the
+// binary-results converter (which stores them as plain numbers) can reuse
+// the exact same column logic as a live run.
+void write_csv_row_with_pct(std::ofstream& file, const Result& res, const uint64_t pct[5]) {
     file << res.timestamp_iso << ","
          << res.impl_name << ","
          << res.scenario << ","
@@ -163,7 +680,323 @@ void write_csv_row(std::ofstream& file, const Result& res) {
          << std::fixed << std::setprecision(4) << res.ns_per_op << ","
          << res.init_time_ns << ","
          << res.counters.relocations << ","
-         << res.counters.conversions << "\n";
+         << res.counters.conversions << ","
+         << res.dispatch << ",";
+    file << pct[0] << "," << pct[1] << "," << pct[2] << "," << pct[3] << "," << pct[4];
+    double agg_mops = (res.total_time_ns > 0)
+        ? (double)res.ops_in_run * 1000.0 / (double)res.total_time_ns : 0.0;
+    file << "," << res.threads << ","
+         << std::fixed << std::setprecision(4) << agg_mops << ","
+         << res.alloc << ","
+         << res.perf.llc_misses << ","
+         << res.perf.dtlb_misses << ","
+         << res.perf.branch_misses << ","
+         << res.perf.instructions << ","
+         << res.written_blocks << ","
+         << std::fixed << std::setprecision(4)
+         << res.min_ns_per_op << ","
+         << res.median_ns_per_op << ","
+         << res.mad_ns_per_op << ","
+         << res.samples << ",";
+    // Aggregate bandwidth for the SCAN_* scenarios: each op touches one
+    // long long slot, so bytes/ns is GB/s directly. Other scenarios report 0.
+    double scan_gbps = (res.scenario.rfind("SCAN_", 0) == 0 && res.total_time_ns > 0)
+        ? (double)res.ops_in_run * (double)sizeof(long long) / (double)res.total_time_ns : 0.0;
+    file << std::fixed << std::setprecision(4) << scan_gbps << ","
+         << res.numa << "\n";
+}
+
+void write_csv_row(std::ofstream& file, const Result& res) {
+    uint64_t pct[5] = {0, 0, 0, 0, 0};
+    if (res.hist_recorded) {
+        pct[0] = res.hist.percentile(0.50);
+        pct[1] = res.hist.percentile(0.90);
+        pct[2] = res.hist.percentile(0.99);
+        pct[3] = res.hist.percentile(0.999);
+        pct[4] = res.hist.max_ns;
+    }
+    write_csv_row_with_pct(file, res, pct);
+}
+
+// ---- binary results format ("IPBR") ----
+// Fixed-size records streamed through a buffered FILE*, so overnight
+// multi-thousand-row campaigns hit the filesystem once instead of
+// formatting and flushing per row. The header count is patched and synced
+// at the end; a crash leaves count=0 and the reader falls back to the file
+// size, so a truncated campaign is still recoverable. Strings are
+// NUL-padded fixed fields; agg_mops and scan_gbps are derived columns and
+// get recomputed at conversion time.
+struct BinResultHeader {
+    char magic[4];            // "IPBR"
+    uint32_t version;         // 1
+    uint64_t count;           // records written; 0 until finish()
+};
+struct BinResultRecord {
+    char timestamp[24];
+    char impl[24];
+    char scenario[24];
+    char dispatch[8];
+    char alloc[12];
+    char numa[16];
+    uint64_t N;
+    uint32_t seed;
+    int32_t rep_id;
+    uint64_t ops_in_run;
+    int64_t total_time_ns;
+    double ns_per_op;
+    int64_t init_time_ns;
+    uint64_t relocations, conversions;
+    uint64_t pct[5];          // p50, p90, p99, p999, max
+    uint64_t threads;
+    uint64_t llc_misses, dtlb_misses, branch_misses, instructions;
+    uint64_t written_blocks;
+    double min_ns_per_op, median_ns_per_op, mad_ns_per_op;
+    uint64_t samples;
+};
+constexpr uint32_t kBinResultVersion = 1;
+
+// Destination for result rows: the historical CSV (formatted and flushed
+// per row, unchanged), or the buffered binary stream behind --format bin.
+class ResultSink {
+public:
+    ResultSink(const std::string& path, bool binary) : bin(binary) {
+        if (bin) {
+            f = std::fopen(path.c_str(), "wb");
+            if (!f) return;
+            std::setvbuf(f, nullptr, _IOFBF, 1u << 20);
+            BinResultHeader h{};
+            std::memcpy(h.magic, "IPBR", 4);
+            h.version = kBinResultVersion;
+            std::fwrite(&h, sizeof h, 1, f);
+        } else {
+            csv.open(path);
+            if (csv.is_open()) write_csv_header(csv);
+        }
+    }
+    ~ResultSink() { finish(); }
+    bool ok() const { return bin ? f != nullptr : csv.is_open(); }
+    void write(const Result& r) {
+        if (bin) {
+            BinResultRecord rec = pack(r);
+            std::fwrite(&rec, sizeof rec, 1, f);
+            ++n;
+        } else {
+            write_csv_row(csv, r);
+            csv.flush();
+        }
+    }
+    void finish() {
+        if (!bin || !f) return;
+        BinResultHeader h{};
+        std::memcpy(h.magic, "IPBR", 4);
+        h.version = kBinResultVersion;
+        h.count = n;
+        std::fseek(f, 0, SEEK_SET);
+        std::fwrite(&h, sizeof h, 1, f);
+        std::fflush(f);
+#if defined(__linux__)
+        fsync(fileno(f));
+#endif
+        std::fclose(f);
+        f = nullptr;
+    }
+private:
+    static void put(char* dst, size_t cap, const std::string& s) {
+        std::memset(dst, 0, cap);
+        std::memcpy(dst, s.data(), std::min(cap - 1, s.size()));
+    }
+    BinResultRecord pack(const Result& r) const {
+        BinResultRecord rec{};
+        put(rec.timestamp, sizeof rec.timestamp, r.timestamp_iso);
+        put(rec.impl,      sizeof rec.impl,      r.impl_name);
+        put(rec.scenario,  sizeof rec.scenario,  r.scenario);
+        put(rec.dispatch,  sizeof rec.dispatch,  r.dispatch);
+        put(rec.alloc,     sizeof rec.alloc,     r.alloc);
+        put(rec.numa,      sizeof rec.numa,      r.numa);
+        rec.N = r.N; rec.seed = r.seed; rec.rep_id = r.rep_id;
+        rec.ops_in_run = r.ops_in_run;
+        rec.total_time_ns = r.total_time_ns;
+        rec.ns_per_op = r.ns_per_op;
+        rec.init_time_ns = r.init_time_ns;
+        rec.relocations = r.counters.relocations;
+        rec.conversions = r.counters.conversions;
+        if (r.hist_recorded) {
+            rec.pct[0] = r.hist.percentile(0.50);
+            rec.pct[1] = r.hist.percentile(0.90);
+            rec.pct[2] = r.hist.percentile(0.99);
+            rec.pct[3] = r.hist.percentile(0.999);
+            rec.pct[4] = r.hist.max_ns;
+        }
+        rec.threads = r.threads;
+        rec.llc_misses = r.perf.llc_misses;
+        rec.dtlb_misses = r.perf.dtlb_misses;
+        rec.branch_misses = r.perf.branch_misses;
+        rec.instructions = r.perf.instructions;
+        rec.written_blocks = r.written_blocks;
+        rec.min_ns_per_op = r.min_ns_per_op;
+        rec.median_ns_per_op = r.median_ns_per_op;
+        rec.mad_ns_per_op = r.mad_ns_per_op;
+        rec.samples = r.samples;
+        return rec;
+    }
+    bool bin;
+    std::FILE* f{nullptr};
+    uint64_t n{0};
+    std::ofstream csv;
+};
+
+// --convert-results: expand a binary results file to the CSV layout so
+// analyze_results.py and break_even.py keep working unmodified.
+int convert_results(const std::string& in_path, const std::string& out_path) {
+    std::FILE* f = std::fopen(in_path.c_str(), "rb");
+    if (!f) { std::cerr << "cannot open " << in_path << "\n"; return 1; }
+    BinResultHeader h{};
+    if (std::fread(&h, sizeof h, 1, f) != 1 || std::memcmp(h.magic, "IPBR", 4) != 0) {
+        std::cerr << in_path << " is not a binary results file\n"; std::fclose(f); return 1;
+    }
+    if (h.version != kBinResultVersion) {
+        std::cerr << "unsupported results version " << h.version << "\n"; std::fclose(f); return 1;
+    }
+    std::ofstream out(out_path);
+    if (!out.is_open()) { std::cerr << "cannot open " << out_path << "\n"; std::fclose(f); return 1; }
+    write_csv_header(out);
+    if (h.count == 0)
+        std::cerr << "warning: count header is 0 (interrupted run?); reading to end of file\n";
+    uint64_t rows = 0;
+    BinResultRecord rec;
+    while ((h.count == 0 || rows < h.count) && std::fread(&rec, sizeof rec, 1, f) == 1) {
+        Result r;
+        r.timestamp_iso = rec.timestamp;
+        r.impl_name = rec.impl;
+        r.scenario = rec.scenario;
+        r.dispatch = rec.dispatch;
+        r.alloc = rec.alloc;
+        r.numa = rec.numa;
+        r.N = rec.N; r.seed = rec.seed; r.rep_id = rec.rep_id;
+        r.ops_in_run = rec.ops_in_run;
+        r.total_time_ns = rec.total_time_ns;
+        r.ns_per_op = rec.ns_per_op;
+        r.init_time_ns = rec.init_time_ns;
+        r.counters.relocations = rec.relocations;
+        r.counters.conversions = rec.conversions;
+        r.threads = rec.threads;
+        r.perf.llc_misses = rec.llc_misses;
+        r.perf.dtlb_misses = rec.dtlb_misses;
+        r.perf.branch_misses = rec.branch_misses;
+        r.perf.instructions = rec.instructions;
+        r.written_blocks = rec.written_blocks;
+        r.min_ns_per_op = rec.min_ns_per_op;
+        r.median_ns_per_op = rec.median_ns_per_op;
+        r.mad_ns_per_op = rec.mad_ns_per_op;
+        r.samples = rec.samples;
+        write_csv_row_with_pct(out, r, rec.pct);
+        ++rows;
+    }
+    std::fclose(f);
+    std::cout << "Converted " << rows << " rows from " << in_path << " to " << out_path << "\n";
+    return 0;
+}
+
+// Op count a scenario performs at a given N, mirroring the M formulas in
+// run_scenario_direct. Returns 0 for scenarios --conform cannot predict
+// (FILL_SWEEP and labeled phase rows carry partial counts by design).
+size_t conform_expected_ops(const std::string& scenario, size_t N) {
+    if (scenario == "INIT_ONLY" || scenario == "CONSTRUCT_AND_INIT") return 1;
+    if (scenario == "READ_UNWRITTEN" || scenario == "READ_BATCH") return std::min((size_t)1e6, 10*N);
+    if (scenario == "WRITE_SEQUENTIAL" || scenario == "WRITE_RANGE" || scenario == "READ_RANGE") return N;
+    if (scenario == "WRITE_RANDOM" || scenario == "ADVERSARIAL_HOTSPOT" || scenario.rfind("ZIPF_",0)==0) return std::min((size_t)1e6, N);
+    if (scenario == "MIXED_SATURATED") return std::min((size_t)5e6, 10*N);
+    if (scenario.rfind("MIXED_",0)==0 || scenario.rfind("SHARED_MIXED_",0)==0) return std::min((size_t)1e6, N);
+    if (scenario == "TRACE_REPLAY") return g_trace_count;  // 0 unless --replay-trace loaded the trace
+    return 0;
+}
+
+// --conform: validate another harness's CSV against this harness's schema
+// and op counts. The first 12 columns are the cross-language contract
+// (the other harnesses stop there; our own files append more); each row's
+// ops_in_run must match what run_scenario_direct would issue for that
+// scenario and N, and ns_per_op must agree with total_time_ns/ops_in_run.
+// Exit status is the verdict so CI can gate on it.
+int conform_results(const std::string& path) {
+    static const char* kContract[12] = {
+        "timestamp_iso","impl_name","scenario","N","seed","rep_id",
+        "ops_in_run","total_time_ns","ns_per_op","init_time_ns_if_recorded",
+        "relocations_count","conversions_count"};
+    std::ifstream f(path);
+    if (!f.is_open()) { std::cerr << "conform: cannot open " << path << "\n"; return 1; }
+    std::string line;
+    if (!std::getline(f, line)) { std::cerr << "conform: " << path << " is empty\n"; return 1; }
+    auto split = [](const std::string& s) {
+        std::vector<std::string> cols; std::string tok; std::stringstream ss(s);
+        while (std::getline(ss, tok, ',')) cols.push_back(tok);
+        return cols;
+    };
+    if (!line.empty() && line.back() == '\r') line.pop_back();
+    auto header = split(line);
+    size_t bad_schema = 0;
+    for (size_t c = 0; c < 12; ++c) {
+        if (c >= header.size() || header[c] != kContract[c]) {
+            std::cerr << "conform: " << path << ": header column " << c+1 << " is '"
+                      << (c < header.size() ? header[c] : "<missing>")
+                      << "', expected '" << kContract[c] << "'\n";
+            ++bad_schema;
+        }
+    }
+    // Our own files append a samples column; when a row aggregated several
+    // samples its ns_per_op is their mean, not total_time_ns/ops_in_run of
+    // the last run, so the timing cross-check only applies to single-sample
+    // rows. The other harnesses stop at 12 columns and are always checked.
+    size_t samples_col = (size_t)-1;
+    for (size_t c = 12; c < header.size(); ++c)
+        if (header[c] == "samples") { samples_col = c; break; }
+    size_t rows = 0, checked = 0, skipped = 0, bad_count = 0, bad_timing = 0, bad_parse = 0;
+    int lineno = 1;
+    while (std::getline(f, line)) {
+        ++lineno;
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty()) continue;
+        ++rows;
+        auto cols = split(line);
+        if (cols.size() < 12) {
+            if (++bad_parse <= 5) std::cerr << "conform: " << path << ":" << lineno << ": only " << cols.size() << " columns\n";
+            continue;
+        }
+        size_t N = 0, ops = 0; long long total_ns = 0; double nspop = 0.0;
+        try {
+            N = std::stoull(cols[3]); ops = std::stoull(cols[6]);
+            total_ns = std::stoll(cols[7]); nspop = std::stod(cols[8]);
+        } catch (const std::exception&) {
+            if (++bad_parse <= 5) std::cerr << "conform: " << path << ":" << lineno << ": non-numeric N/ops/time\n";
+            continue;
+        }
+        size_t expected = conform_expected_ops(cols[2], N);
+        if (expected == 0) { ++skipped; continue; }
+        ++checked;
+        if (ops != expected) {
+            if (++bad_count <= 5)
+                std::cerr << "conform: " << path << ":" << lineno << ": " << cols[2] << " N=" << N
+                          << " ran " << ops << " ops, expected " << expected << "\n";
+            continue;
+        }
+        if (samples_col < cols.size()) {
+            try { if (std::stoull(cols[samples_col]) > 1) continue; }
+            catch (const std::exception&) {}
+        }
+        // ns_per_op is written with 4 decimals; allow rounding plus 1% slack.
+        double derived = ops ? (double)total_ns / (double)ops : 0.0;
+        if (std::abs(nspop - derived) > std::max(0.001, 0.01 * derived)) {
+            if (++bad_timing <= 5)
+                std::cerr << "conform: " << path << ":" << lineno << ": ns_per_op " << nspop
+                          << " disagrees with total_time_ns/ops_in_run = " << derived << "\n";
+        }
+    }
+    size_t failures = bad_schema + bad_parse + bad_count + bad_timing;
+    std::cout << "conform: " << path << ": " << rows << " rows, " << checked
+              << " checked, " << skipped << " skipped (unpredicted scenario), "
+              << bad_schema << " schema / " << bad_parse << " parse / " << bad_count
+              << " op-count / " << bad_timing << " timing failures -- "
+              << (failures ? "FAIL" : "OK") << "\n";
+    return failures ? 1 : 0;
 }
 
 using TimePoint = std::chrono::high_resolution_clock::time_point;
@@ -172,39 +1005,117 @@ long long duration_ns(TimePoint start, TimePoint end) {
     return std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
 }
 
-void run_scenario(IInitializableArray& array, const Config& config, Result& result) {
+// Core scenario driver. Templated on the array type: instantiated with a
+// concrete class the calls are monomorphized and inlinable ("static"
+// dispatch); instantiated with IInitializableArray every op pays the
+// indirect call ("virtual"), which is what the paper-style harness measured.
+template<class Array>
+void run_scenario_direct(Array& array, const Config& config, Result& result) {
     std::mt19937 rng(config.seed);
     std::uniform_int_distribution<size_t> index_dist(0, config.N - 1);
     std::uniform_int_distribution<long long> value_dist(-1000, 1000);
-    
+
+    // With --latency-hist each op in the per-op loops is timed individually
+    // into preallocated buckets; otherwise per_op compiles down to the body.
+    LatencyHistogram* hist = config.latency_hist ? &result.hist : nullptr;
+    auto per_op = [&](auto&& body){
+        if(hist){ auto t0=time_now(); body(); auto t1=time_now(); hist->record((uint64_t)duration_ns(t0,t1)); }
+        else body();
+    };
+
     array.reset_counters();
     
     if (config.scenario == "INIT_ONLY") {
-        auto start = time_now(); array.init(42); auto end = time_now();
+        perf_begin(); auto start = time_now(); array.init(42); auto end = time_now(); perf_end(result.perf);
         result.ops_in_run = 1; result.total_time_ns = duration_ns(start, end);
         result.init_time_ns = result.total_time_ns;
     } else if (config.scenario == "READ_UNWRITTEN") {
         array.init(123);
         size_t M = std::min((size_t)1e6, 10 * config.N);
         std::vector<size_t> indices(M); for(size_t i=0;i<M;++i) indices[i] = index_dist(rng);
-        auto start = time_now();
+        perf_begin(); auto start = time_now();
         volatile long long sink=0;
-        for (size_t i = 0; i < M; ++i) { sink ^= array.read(indices[i]); }
-        auto end = time_now();
+        for (size_t i = 0; i < M; ++i) per_op([&]{ sink ^= array.read(indices[i]); });
+        auto end = time_now(); perf_end(result.perf);
+        result.ops_in_run=M; result.total_time_ns=duration_ns(start,end);
+    } else if (config.scenario == "READ_BATCH") {
+        // Same index stream as READ_UNWRITTEN, but resolved through
+        // read_batch() in fixed-size chunks so chained impls can prefetch.
+        array.init(123);
+        array.set_prefetch_distance(config.prefetch_dist);
+        size_t M = std::min((size_t)1e6, 10 * config.N);
+        std::vector<size_t> indices(M); for(size_t i=0;i<M;++i) indices[i] = index_dist(rng);
+        std::vector<long long> out(M, 0);
+        const size_t batch = 1024;
+        perf_begin(); auto start = time_now();
+        for (size_t i = 0; i < M; i += batch) array.read_batch(&indices[i], std::min(batch, M-i), &out[i]);
+        auto end = time_now(); perf_end(result.perf);
+        volatile long long sink=0; for(size_t i=0;i<M;++i) sink ^= out[i];
         result.ops_in_run=M; result.total_time_ns=duration_ns(start,end);
     } else if (config.scenario == "WRITE_SEQUENTIAL") {
         array.init(0);
-        auto start = time_now();
-        for (size_t i = 0; i < config.N; ++i) array.write(i, i);
-        auto end = time_now();
+        perf_begin(); auto start = time_now();
+        for (size_t i = 0; i < config.N; ++i) per_op([&]{ array.write(i, i); });
+        auto end = time_now(); perf_end(result.perf);
         result.ops_in_run=config.N; result.total_time_ns=duration_ns(start,end);
     } else if (config.scenario == "WRITE_RANDOM") {
         array.init(0);
         size_t M = std::min((size_t)1e6, config.N);
         std::vector<size_t> indices(M); for(size_t i=0;i<M;++i) indices[i] = index_dist(rng);
-        auto start = time_now();
-        for (size_t i = 0; i < M; ++i) array.write(indices[i], value_dist(rng));
-        auto end = time_now();
+        perf_begin(); auto start = time_now();
+        for (size_t i = 0; i < M; ++i) per_op([&]{ array.write(indices[i], value_dist(rng)); });
+        auto end = time_now(); perf_end(result.perf);
+        result.ops_in_run=M; result.total_time_ns=duration_ns(start,end);
+    } else if (config.scenario == "WRITE_RANGE") {
+        array.init(0);
+        std::vector<long long> src(config.N); for(size_t i=0;i<config.N;++i) src[i]=(long long)i;
+        const size_t chunk = 4096;
+        perf_begin(); auto start = time_now();
+        for (size_t i=0;i<config.N;i+=chunk) array.write_range(i, std::min(config.N, i+chunk), &src[i]);
+        auto end = time_now(); perf_end(result.perf);
+        result.ops_in_run=config.N; result.total_time_ns=duration_ns(start,end);
+    } else if (config.scenario == "READ_RANGE") {
+        array.init(123);
+        // Untimed random writes first so ranges cross written and unwritten blocks.
+        for(size_t i=0;i<config.N/2;++i) array.write(index_dist(rng), value_dist(rng));
+        std::vector<long long> dst(config.N, 0);
+        const size_t chunk = 4096;
+        array.reset_counters();
+        perf_begin(); auto start = time_now();
+        for(size_t i=0;i<config.N;i+=chunk) array.read_range(i, std::min(config.N, i+chunk), &dst[i]);
+        auto end = time_now(); perf_end(result.perf);
+        volatile long long sink=0; for(size_t i=0;i<config.N;++i) sink ^= dst[i];
+        result.ops_in_run=config.N; result.total_time_ns=duration_ns(start,end);
+    } else if (config.scenario == "SCAN_SUM") {
+        // Aggregate bandwidth once the array is saturated: an untimed fill
+        // drives b to N_blocks so sum_range covers the whole table through
+        // its flat fast path, then full-table sums are timed back to back.
+        array.init(42);
+        for (size_t i = 0; i < config.N; ++i) array.write(i, (long long)i);
+        size_t passes = std::max((size_t)1, (size_t)1e7 / config.N);
+        array.reset_counters();
+        perf_begin(); auto start = time_now();
+        volatile long long sink=0;
+        for (size_t p = 0; p < passes; ++p) sink ^= array.sum_range(0, config.N);
+        auto end = time_now(); perf_end(result.perf);
+        result.ops_in_run=passes*config.N; result.total_time_ns=duration_ns(start,end);
+    } else if (config.scenario == "MIXED_SATURATED") {
+        // Untimed fill phase drives b to N_blocks, then a long 50/50 stream
+        // measures steady-state throughput on the saturated fast path.
+        array.init(42);
+        for (size_t i = 0; i < config.N; ++i) array.write(i, (long long)i);
+        size_t M = std::min((size_t)5e6, 10 * config.N);
+        std::vector<size_t> indices(M);
+        std::vector<uint8_t> ops(M);
+        for(size_t i=0;i<M;++i){ indices[i]=index_dist(rng); ops[i]=(rng()%100<50?0u:1u); }
+        array.reset_counters();
+        perf_begin(); auto start = time_now();
+        volatile long long sink=0;
+        for (size_t i = 0; i < M; ++i) per_op([&]{
+            if (ops[i]==0) sink ^= array.read(indices[i]);
+            else array.write(indices[i], value_dist(rng));
+        });
+        auto end = time_now(); perf_end(result.perf);
         result.ops_in_run=M; result.total_time_ns=duration_ns(start,end);
     } else if (config.scenario.rfind("MIXED_",0)==0) {
         std::string perc = config.scenario.substr(6);
@@ -214,60 +1125,487 @@ void run_scenario(IInitializableArray& array, const Config& config, Result& resu
         size_t M = std::min((size_t)1e6, config.N);
         std::vector<size_t> indices(M);
         std::vector<uint8_t> ops(M);
-        for(size_t i=0;i<M;++i){ indices[i]=index_dist(rng); ops[i]=(rng()%100<read_pct?0u:1u); }
-        auto start = time_now();
+        for(size_t i=0;i<M;++i){ indices[i]=index_dist(rng); ops[i]=(rng()%100<(unsigned)read_pct?0u:1u); }
+        perf_begin(); auto start = time_now();
         volatile long long sink=0;
-        for (size_t i = 0; i < M; ++i) {
+        for (size_t i = 0; i < M; ++i) per_op([&]{
             if (ops[i]==0) sink ^= array.read(indices[i]);
             else array.write(indices[i], value_dist(rng));
-        }
-        auto end = time_now();
+        });
+        auto end = time_now(); perf_end(result.perf);
         result.ops_in_run=M; result.total_time_ns=duration_ns(start,end);
     } else if (config.scenario == "ADVERSARIAL_HOTSPOT") {
         array.init(0);
         size_t M = std::min((size_t)1e6, config.N);
-        size_t hotspot_size = std::max((size_t)1, config.N/10);
-        auto start = time_now();
+        size_t hotspot_size = std::max((size_t)1, (size_t)((double)config.N * config.hotspot_frac));
+        perf_begin(); auto start = time_now();
         for (size_t i=0;i<M;++i){
-            size_t idx = (rng()%2==0) ? (rng()%hotspot_size) : index_dist(rng);
-            array.write(idx, value_dist(rng));
+            size_t idx = (rng()%100 < (unsigned)config.hotspot_pct) ? (rng()%hotspot_size) : index_dist(rng);
+            per_op([&]{ array.write(idx, value_dist(rng)); });
+        }
+        auto end = time_now(); perf_end(result.perf);
+        result.ops_in_run=M; result.total_time_ns=duration_ns(start,end);
+    } else if (config.scenario.rfind("ZIPF_",0)==0) {
+        // Skewed random writes: same shape as WRITE_RANDOM but the index
+        // stream is Zipfian with the theta encoded in the scenario name.
+        // Indices are precomputed so sampling cost stays out of the loop.
+        double zipf_theta = std::stod(config.scenario.substr(5));
+        array.init(0);
+        ZipfianSampler zipf(config.N, zipf_theta);
+        size_t M = std::min((size_t)1e6, config.N);
+        std::vector<size_t> indices(M); for(size_t i=0;i<M;++i) indices[i] = zipf(rng);
+        perf_begin(); auto start = time_now();
+        for (size_t i = 0; i < M; ++i) per_op([&]{ array.write(indices[i], value_dist(rng)); });
+        auto end = time_now(); perf_end(result.perf);
+        result.ops_in_run=M; result.total_time_ns=duration_ns(start,end);
+    } else if (config.scenario == "FILL_SWEEP") {
+        // Random writes with geometric checkpoints at 1%,2%,4%,...,100% of N
+        // writes. Each checkpoint snapshots elapsed time, relocation work and
+        // the frontier b, so the front-loaded cost of the chained schemes
+        // shows up as a curve instead of an end-of-run total. Indices are
+        // drawn in-loop like ADVERSARIAL_HOTSPOT to avoid an O(N) side table.
+        array.init(0);
+        size_t M = config.N;
+        std::vector<size_t> marks;
+        for (double f = 0.01; f < 1.0; f *= 2) {
+            size_t m = (size_t)(f * (double)M);
+            if (m > 0 && (marks.empty() || m > marks.back())) marks.push_back(m);
+        }
+        if (marks.empty() || marks.back() != M) marks.push_back(M);
+        perf_begin(); auto start = time_now();
+        size_t done = 0;
+        for (size_t m : marks) {
+            for (; done < m; ++done) per_op([&]{ array.write(index_dist(rng), value_dist(rng)); });
+            result.fill_checkpoints.push_back(
+                {done, duration_ns(start, time_now()), array.get_counters(), array.written_blocks(), ""});
+        }
+        auto end = time_now(); perf_end(result.perf);
+        result.ops_in_run=M; result.total_time_ns=duration_ns(start,end);
+        result.written_blocks = array.written_blocks();
+    } else if (config.scenario == "WORKLOAD") {
+        // Phased lifecycle from --workload, executed as one timed sequence
+        // so frontier state and cache residency carry across transitions --
+        // e.g. the cost cliff right after an init reset while the table is
+        // still hot, which stitched-together single-phase rows cannot show.
+        // Each phase lands as its own labeled row with per-phase deltas.
+        if (g_workload.empty()) throw std::invalid_argument("WORKLOAD requires --workload");
+        auto streams = build_workload_streams(config.N, rng);
+        array.init(0);
+        array.reset_counters();
+        size_t total_ops = 0;
+        perf_begin(); auto start = time_now();
+        volatile long long sink=0;
+        for (size_t p = 0; p < g_workload.size(); ++p) {
+            const auto& ph = g_workload[p];
+            auto p0 = time_now();
+            if (ph.is_init) {
+                per_op([&]{ array.init(ph.init_value); });
+                total_ops += 1;
+                result.fill_checkpoints.push_back(
+                    {1, duration_ns(p0, time_now()), array.get_counters(), array.written_blocks(), ph.label});
+                continue;
+            }
+            const auto& st = streams[p];
+            for (size_t i = 0; i < ph.ops; ++i) per_op([&]{
+                if (st.is_read[i]) sink ^= array.read(st.idx[i]);
+                else array.write(st.idx[i], value_dist(rng));
+            });
+            total_ops += ph.ops;
+            result.fill_checkpoints.push_back(
+                {ph.ops, duration_ns(p0, time_now()), array.get_counters(), array.written_blocks(), ph.label});
         }
-        auto end = time_now();
+        auto end = time_now(); perf_end(result.perf);
+        result.ops_in_run=total_ops; result.total_time_ns=duration_ns(start,end);
+        result.written_blocks = array.written_blocks();
+    } else if (config.scenario == "TRACE_REPLAY") {
+        // Streams the mmapped trace: one mask and one shift per op.
+        if (!g_trace_data) throw std::invalid_argument("TRACE_REPLAY requires --replay-trace");
+        const TraceRecord* ops = g_trace_data;
+        size_t M = g_trace_count;
+        perf_begin(); auto start = time_now();
+        volatile long long sink=0;
+        for (size_t i = 0; i < M; ++i) per_op([&]{
+            uint64_t oi = ops[i].op_index;
+            size_t idx = (size_t)(oi & kTraceIndexMask);
+            switch (oi >> kTraceOpShift) {
+                case kTraceRead:  sink ^= array.read(idx); break;
+                case kTraceWrite: array.write(idx, ops[i].value); break;
+                default:          array.init(ops[i].value); break;
+            }
+        });
+        auto end = time_now(); perf_end(result.perf);
         result.ops_in_run=M; result.total_time_ns=duration_ns(start,end);
     } else {
         throw std::invalid_argument("Unknown scenario: " + config.scenario);
     }
     if (result.ops_in_run>0) result.ns_per_op = double(result.total_time_ns)/result.ops_in_run;
     result.counters = array.get_counters();
+    result.hist_recorded = (hist != nullptr && result.hist.total > 0);
 }
 
-void run_scenario_direct_stdvector(const Config& config, Result& result) {
+void run_scenario(IInitializableArray& array, const Config& config, Result& result) {
+    run_scenario_direct<IInitializableArray>(array, config, result);
+}
+
+// CONSTRUCT_AND_INIT measures cold-start latency: the constructor and the
+// first init() together. The array has to be built inside the timed region,
+// so it cannot go through run_scenario_direct, which takes a live instance.
+template<class Array, class... CtorArgs>
+void time_construct_and_init(Result& result, CtorArgs&&... args) {
+    perf_begin(); auto start = time_now();
+    Array a(std::forward<CtorArgs>(args)...);
+    a.init(42);
+    auto end = time_now(); perf_end(result.perf);
+    result.ops_in_run = 1;
+    result.total_time_ns = duration_ns(start, end);
+    result.ns_per_op = (double)result.total_time_ns;
+    result.init_time_ns = result.total_time_ns;
+    result.counters = a.get_counters();
+}
+
+bool run_construct_and_init_static(const std::string& impl_name, const Config& config, Result& result) {
+    const size_t N = config.N;
+    const AllocMode am = alloc_mode_of(config);
+    if (impl_name=="std_vector")    time_construct_and_init<StdVectorWrapper>(result, N);
+    else if (impl_name=="sec3")     time_construct_and_init<InPlaceArraySec3>(result, N, am);
+    else if (impl_name=="sec4")     time_construct_and_init<InPlaceArraySec4>(result, N, am);
+    else if (impl_name=="sec3_i32") time_construct_and_init<InPlaceArraySec3T<std::int32_t>>(result, N, am);
+    else if (impl_name=="sec4_i32") time_construct_and_init<InPlaceArraySec4T<std::int32_t>>(result, N, am);
+    else if (impl_name=="sec3_i16") time_construct_and_init<InPlaceArraySec3T<std::int16_t>>(result, N, am);
+    else if (impl_name=="sec4_i16") time_construct_and_init<InPlaceArraySec4T<std::int16_t>>(result, N, am);
+    else if (impl_name=="sec3_raw") time_construct_and_init<InPlaceArraySec3T<long long, StatsOff>>(result, N, am);
+    else if (impl_name=="sec4_raw") time_construct_and_init<InPlaceArraySec4T<long long, StatsOff>>(result, N, am);
+    else if (impl_name=="sec4_c32") time_construct_and_init<InPlaceArraySec4C32>(result, N, am);
+    else if (impl_name=="sec4_bf")  time_construct_and_init<InPlaceArraySec4BF>(result, N, am);
+    else if (impl_name=="blk8")     time_construct_and_init<InPlaceArrayBlocked<8>>(result, N, am);
+    else if (impl_name=="blk16")    time_construct_and_init<InPlaceArrayBlocked<16>>(result, N, am);
+    else if (impl_name=="epoch_stamp") time_construct_and_init<EpochStampArray>(result, N);
+    else if (impl_name=="bitmap")   time_construct_and_init<BitmapArray>(result, N);
+    else if (impl_name=="adaptive") time_construct_and_init<AdaptiveInitArray>(result, N);
+    else if (impl_name=="concurrent") time_construct_and_init<ConcurrentInPlaceArray>(result, N);
+    else return false;
+    return true;
+}
+
+// CHECKPOINT_RESTORE times the restart phases separately: save (one
+// sequential write of header + buffer), cold load (header validation plus
+// an mmap, O(1) in N), and first-access fault-in (a full-table sum that
+// touches every page of the fresh mapping). One CSV row per phase, labeled
+// through the checkpoint row mechanism.
+template<class Array>
+void time_checkpoint_restore(const Config& config, Result& result) {
+    const AllocMode am = alloc_mode_of(config);
+    Array a(config.N, am);
+    a.init(42);
+    // Half-fill with random writes so the image carries a live mix of
+    // settled blocks and chain-encoded slots.
     std::mt19937 rng(config.seed);
     std::uniform_int_distribution<size_t> index_dist(0, config.N - 1);
     std::uniform_int_distribution<long long> value_dist(-1000, 1000);
-    std::vector<long long> A(config.N, 0);
+    for (size_t i = 0; i < config.N/2; ++i) a.write(index_dist(rng), value_dist(rng));
+    // The path embeds seed and rep so concurrent runs never share a file:
+    // the threaded fan-out gives every worker its own seed, and one worker
+    // truncating an image another has mapped is a SIGBUS.
+    const std::string path = "checkpoint_" + std::string(a.name())
+                           + "_s" + std::to_string(config.seed)
+                           + "_r" + std::to_string(config.rep_id) + ".ipck";
+
+    perf_begin(); auto t0 = time_now();
+    a.save(path);
+    auto t1 = time_now();
+    auto restored = Array::load(path);
+    auto t2 = time_now();
+    volatile long long sink = restored->sum_range(0, config.N);
+    auto t3 = time_now(); perf_end(result.perf);
+
+    long long expect = a.sum_range(0, config.N);
+    std::remove(path.c_str());
+    if (sink != expect)
+        throw std::runtime_error("checkpoint restore mismatch: sums differ");
+
+    result.fill_checkpoints.push_back({config.N, duration_ns(t0,t1), Counters{}, a.written_blocks(), "CHECKPOINT_SAVE"});
+    result.fill_checkpoints.push_back({1,        duration_ns(t1,t2), Counters{}, restored->written_blocks(), "CHECKPOINT_LOAD"});
+    result.fill_checkpoints.push_back({config.N, duration_ns(t2,t3), Counters{}, restored->written_blocks(), "CHECKPOINT_FAULTIN"});
+    result.ops_in_run = config.N;
+    result.total_time_ns = duration_ns(t0, t3);
+    result.ns_per_op = (double)result.total_time_ns / (double)config.N;
+}
 
+// POOL_CHURN: per-request lifecycle cost. Each cycle acquires an array,
+// runs a small op burst (the "query"), and tears it down -- once with a
+// fresh construct/destroy per request and once through ArrayPool, which
+// recycles instances with only the O(1) init() on acquire. One labeled row
+// per variant; ns_per_op is the cost of a whole request cycle.
+template<class Array>
+void time_pool_churn(const Config& config, Result& result) {
+    const AllocMode am = alloc_mode_of(config);
+    const size_t cycles = 1000;
+    const size_t burst = 64;
+    std::mt19937 rng(config.seed);
+    std::uniform_int_distribution<size_t> index_dist(0, config.N - 1);
+    std::vector<size_t> idx(burst);
+    for (auto& x : idx) x = index_dist(rng);
+
+    // An empty pool never gets releases, so acquire() constructs every
+    // time: same code path, pool bookkeeping included, fresh lifecycle.
+    ArrayPool<Array> fresh(config.N, am);
+    ArrayPool<Array> pool(config.N, am);
+    volatile long long sink = 0;
+
+    perf_begin(); auto t0 = time_now();
+    for (size_t c = 0; c < cycles; ++c) {
+        auto a = fresh.acquire(42);
+        for (size_t k = 0; k < burst; ++k) a->write(idx[k], (long long)k);
+        for (size_t k = 0; k < burst; ++k) sink ^= a->read(idx[k]);
+        a.reset();
+    }
+    auto t1 = time_now();
+    pool.release(pool.acquire(42));  // warm one instance outside the timing
+    auto t2 = time_now();
+    for (size_t c = 0; c < cycles; ++c) {
+        auto a = pool.acquire(42);
+        for (size_t k = 0; k < burst; ++k) a->write(idx[k], (long long)k);
+        for (size_t k = 0; k < burst; ++k) sink ^= a->read(idx[k]);
+        pool.release(std::move(a));
+    }
+    auto t3 = time_now(); perf_end(result.perf);
+
+    result.fill_checkpoints.push_back({cycles, duration_ns(t0,t1), Counters{}, 0, "POOL_CHURN_FRESH"});
+    result.fill_checkpoints.push_back({cycles, duration_ns(t2,t3), Counters{}, 0, "POOL_CHURN_POOLED"});
+    result.ops_in_run = 2 * cycles;
+    result.total_time_ns = duration_ns(t0,t1) + duration_ns(t2,t3);
+    result.ns_per_op = (double)result.total_time_ns / (double)result.ops_in_run;
+}
+
+bool run_pool_churn_static(const std::string& impl_name, const Config& config, Result& result) {
+    if (impl_name=="std_vector")    time_pool_churn<StdVectorWrapper>(config, result);
+    else if (impl_name=="sec3")     time_pool_churn<InPlaceArraySec3>(config, result);
+    else if (impl_name=="sec4")     time_pool_churn<InPlaceArraySec4>(config, result);
+    else if (impl_name=="sec3_i32") time_pool_churn<InPlaceArraySec3T<std::int32_t>>(config, result);
+    else if (impl_name=="sec4_i32") time_pool_churn<InPlaceArraySec4T<std::int32_t>>(config, result);
+    else if (impl_name=="sec3_i16") time_pool_churn<InPlaceArraySec3T<std::int16_t>>(config, result);
+    else if (impl_name=="sec4_i16") time_pool_churn<InPlaceArraySec4T<std::int16_t>>(config, result);
+    else if (impl_name=="sec3_raw") time_pool_churn<InPlaceArraySec3T<long long, StatsOff>>(config, result);
+    else if (impl_name=="sec4_raw") time_pool_churn<InPlaceArraySec4T<long long, StatsOff>>(config, result);
+    else if (impl_name=="sec4_c32") time_pool_churn<InPlaceArraySec4C32>(config, result);
+    else if (impl_name=="sec4_bf")  time_pool_churn<InPlaceArraySec4BF>(config, result);
+    else if (impl_name=="blk8")     time_pool_churn<InPlaceArrayBlocked<8>>(config, result);
+    else if (impl_name=="blk16")    time_pool_churn<InPlaceArrayBlocked<16>>(config, result);
+    else if (impl_name=="epoch_stamp") time_pool_churn<EpochStampArray>(config, result);
+    else if (impl_name=="bitmap")   time_pool_churn<BitmapArray>(config, result);
+    else if (impl_name=="adaptive") time_pool_churn<AdaptiveInitArray>(config, result);
+    else if (impl_name=="concurrent") time_pool_churn<ConcurrentInPlaceArray>(config, result);
+    else return false;
+    return true;
+}
+
+bool run_checkpoint_restore_static(const std::string& impl_name, const Config& config, Result& result) {
+    if (impl_name=="sec3")          time_checkpoint_restore<InPlaceArraySec3>(config, result);
+    else if (impl_name=="sec4")     time_checkpoint_restore<InPlaceArraySec4>(config, result);
+    else if (impl_name=="sec3_i32") time_checkpoint_restore<InPlaceArraySec3T<std::int32_t>>(config, result);
+    else if (impl_name=="sec4_i32") time_checkpoint_restore<InPlaceArraySec4T<std::int32_t>>(config, result);
+    else if (impl_name=="sec3_i16") time_checkpoint_restore<InPlaceArraySec3T<std::int16_t>>(config, result);
+    else if (impl_name=="sec4_i16") time_checkpoint_restore<InPlaceArraySec4T<std::int16_t>>(config, result);
+    else if (impl_name=="sec3_raw") time_checkpoint_restore<InPlaceArraySec3T<long long, StatsOff>>(config, result);
+    else if (impl_name=="sec4_raw") time_checkpoint_restore<InPlaceArraySec4T<long long, StatsOff>>(config, result);
+    else if (impl_name=="sec4_c32") time_checkpoint_restore<InPlaceArraySec4C32>(config, result);
+    else if (impl_name=="sec4_bf")  time_checkpoint_restore<InPlaceArraySec4BF>(config, result);
+    else return false;
+    return true;
+}
+
+// Constructs the named impl as its concrete type and drives it through the
+// monomorphized runner. Returns false for names with no static mapping.
+bool run_scenario_static(const std::string& impl_name, const Config& config, Result& result) {
+    const size_t N = config.N;
+    const AllocMode am = alloc_mode_of(config);
+    if (config.scenario == "CONSTRUCT_AND_INIT")
+        return run_construct_and_init_static(impl_name, config, result);
+    if (config.scenario == "CHECKPOINT_RESTORE")
+        return run_checkpoint_restore_static(impl_name, config, result);
+    if (config.scenario == "POOL_CHURN")
+        return run_pool_churn_static(impl_name, config, result);
+    if (impl_name=="std_vector")    { StdVectorWrapper a(N); run_scenario_direct(a, config, result); }
+    else if (impl_name=="sec3")     { InPlaceArraySec3 a(N, am); run_scenario_direct(a, config, result); }
+    else if (impl_name=="sec4")     { InPlaceArraySec4 a(N, am); run_scenario_direct(a, config, result); }
+    else if (impl_name=="sec3_i32") { InPlaceArraySec3T<std::int32_t> a(N, am); run_scenario_direct(a, config, result); }
+    else if (impl_name=="sec4_i32") { InPlaceArraySec4T<std::int32_t> a(N, am); run_scenario_direct(a, config, result); }
+    else if (impl_name=="sec3_i16") { InPlaceArraySec3T<std::int16_t> a(N, am); run_scenario_direct(a, config, result); }
+    else if (impl_name=="sec4_i16") { InPlaceArraySec4T<std::int16_t> a(N, am); run_scenario_direct(a, config, result); }
+    else if (impl_name=="sec3_raw") { InPlaceArraySec3T<long long, StatsOff> a(N, am); run_scenario_direct(a, config, result); }
+    else if (impl_name=="sec4_raw") { InPlaceArraySec4T<long long, StatsOff> a(N, am); run_scenario_direct(a, config, result); }
+    else if (impl_name=="sec4_c32") { InPlaceArraySec4C32 a(N, am); run_scenario_direct(a, config, result); }
+    else if (impl_name=="sec4_bf")  { InPlaceArraySec4BF a(N, am); run_scenario_direct(a, config, result); }
+    else if (impl_name=="blk8")     { InPlaceArrayBlocked<8> a(N, am); run_scenario_direct(a, config, result); }
+    else if (impl_name=="blk16")    { InPlaceArrayBlocked<16> a(N, am); run_scenario_direct(a, config, result); }
+    else if (impl_name=="epoch_stamp") { EpochStampArray a(N); run_scenario_direct(a, config, result); }
+    else if (impl_name=="bitmap")   { BitmapArray a(N); run_scenario_direct(a, config, result); }
+    else if (impl_name=="adaptive") { AdaptiveInitArray a(N); run_scenario_direct(a, config, result); }
+    else if (impl_name=="concurrent") { ConcurrentInPlaceArray a(N); run_scenario_direct(a, config, result); }
+    else return false;
+    return true;
+}
+
+// --find-breakeven: adaptive search for the crossover frontier between a
+// challenger impl and the std_vector baseline, replacing the offline grid
+// sweep + break_even.py pass. Each probe is the median of three static-
+// dispatch runs; the bisection is geometric in N (the curves cross once in
+// log-N for these workloads), and for MIXED_* scenarios a second bisection
+// walks the read percentage at the top N.
+bool run_scenario_static(const std::string& impl_name, const Config& config, Result& result);
+
+double measure_ns_per_op(const std::string& impl, const std::string& scenario,
+                         size_t N, unsigned seed, const std::string& alloc) {
+    std::vector<double> v;
+    for (int r = 1; r <= 3; ++r) {
+        Config c{impl, scenario, N, seed + (unsigned)r, r, 8, false, alloc, 0.10, 50};
+        Result res;
+        if (!run_scenario_static(impl, c, res))
+            throw std::invalid_argument("unknown impl for break-even: " + impl);
+        v.push_back(res.ns_per_op);
+    }
+    std::sort(v.begin(), v.end());
+    return v[1];
+}
+
+int run_breakeven(const std::string& challenger, const std::string& scenario,
+                  size_t N_lo, size_t N_hi, unsigned seed, const std::string& alloc) {
+    const std::string baseline = "std_vector";
+    // Keep every probe valid for all impls (sec4/blk need N%4==0).
+    auto align_N = [](size_t N){ return std::max((size_t)4, N & ~(size_t)3); };
+    auto diff_at = [&](size_t N){
+        double c = measure_ns_per_op(challenger, scenario, N, seed, alloc);
+        double b = measure_ns_per_op(baseline, scenario, N, seed, alloc);
+        std::cout << "  N=" << N << ": " << challenger << "=" << std::fixed << std::setprecision(2)
+                  << c << " ns/op, " << baseline << "=" << b << " ns/op\n";
+        return c - b;
+    };
+    std::cout << "Break-even search: " << challenger << " vs " << baseline
+              << " on " << scenario << ", N in [" << N_lo << ", " << N_hi << "]\n";
+    N_lo = align_N(N_lo); N_hi = align_N(N_hi);
+    double d_lo = diff_at(N_lo), d_hi = diff_at(N_hi);
+    if ((d_lo < 0) == (d_hi < 0)) {
+        std::cout << "No crossover in [" << N_lo << ", " << N_hi << "]: " << challenger
+                  << (d_lo < 0 ? " wins" : " loses") << " across the whole bracket\n";
+    } else {
+        for (int iter = 0; iter < 30 && (double)N_hi/(double)N_lo > 1.05; ++iter) {
+            size_t mid = align_N((size_t)std::sqrt((double)N_lo * (double)N_hi));
+            if (mid <= N_lo || mid >= N_hi) break;
+            double d = diff_at(mid);
+            if ((d < 0) == (d_lo < 0)) { N_lo = mid; d_lo = d; }
+            else                       { N_hi = mid; d_hi = d; }
+        }
+        std::cout << "Crossover bracketed: N in [" << N_lo << ", " << N_hi << "]\n";
+    }
+    if (scenario.rfind("MIXED_",0)==0 && scenario != "MIXED_SATURATED") {
+        // Second axis: at the top N, where along the read/write mix does the
+        // challenger start winning?
+        size_t N = align_N(N_hi);
+        auto mix_diff = [&](int read_pct){
+            std::string s = "MIXED_R" + std::to_string(read_pct) + "W" + std::to_string(100-read_pct);
+            double c = measure_ns_per_op(challenger, s, N, seed, alloc);
+            double b = measure_ns_per_op(baseline, s, N, seed, alloc);
+            std::cout << "  " << s << ": " << challenger << "=" << std::fixed << std::setprecision(2)
+                      << c << " ns/op, " << baseline << "=" << b << " ns/op\n";
+            return c - b;
+        };
+        std::cout << "Read-ratio search at N=" << N << ":\n";
+        int p_lo = 1, p_hi = 99;
+        double m_lo = mix_diff(p_lo), m_hi = mix_diff(p_hi);
+        if ((m_lo < 0) == (m_hi < 0)) {
+            std::cout << "No mix crossover: " << challenger
+                      << (m_lo < 0 ? " wins" : " loses") << " at every read ratio\n";
+        } else {
+            while (p_hi - p_lo > 2) {
+                int mid = (p_lo + p_hi) / 2;
+                double d = mix_diff(mid);
+                if ((d < 0) == (m_lo < 0)) { p_lo = mid; m_lo = d; }
+                else                       { p_hi = mid; m_hi = d; }
+            }
+            std::cout << "Mix crossover bracketed: read ratio in [" << p_lo << "%, " << p_hi << "%]\n";
+        }
+    }
+    return 0;
+}
+
+void run_scenario_direct_stdvector(const Config& config, Result& result) {
+    std::mt19937 rng(config.seed);
+    std::uniform_int_distribution<size_t> index_dist(0, config.N - 1);
+    std::uniform_int_distribution<long long> value_dist(-1000, 1000);
     auto time_now = [](){ return std::chrono::high_resolution_clock::now(); };
     auto dur_ns = [](auto s, auto e){return std::chrono::duration_cast<std::chrono::nanoseconds>(e-s).count();};
 
+    // Cold start: for the baseline, constructing the vector IS the init.
+    if (config.scenario == "CONSTRUCT_AND_INIT") {
+        perf_begin(); auto s=time_now(); std::vector<long long> A0(config.N, 42); auto e=time_now(); perf_end(result.perf);
+        volatile long long sink=A0[config.N/2]; (void)sink;
+        result.ops_in_run=1; result.total_time_ns=dur_ns(s,e);
+        result.ns_per_op=(double)result.total_time_ns; result.init_time_ns=result.total_time_ns;
+        return;
+    }
+    std::vector<long long> A(config.N, 0);
+
     if (config.scenario == "INIT_ONLY") {
-        auto s=time_now(); std::fill(A.begin(), A.end(), 42); auto e=time_now();
+        perf_begin(); auto s=time_now(); std::fill(A.begin(), A.end(), 42); auto e=time_now(); perf_end(result.perf);
         result.ops_in_run=1; result.total_time_ns=dur_ns(s,e); result.init_time_ns=result.total_time_ns;
     } else if (config.scenario == "READ_UNWRITTEN") {
         std::fill(A.begin(), A.end(), 123);
         size_t M = std::min((size_t)1e6, 10*config.N);
         std::vector<size_t> idx(M); for(size_t i=0;i<M;++i) idx[i]=index_dist(rng);
-        auto s=time_now(); volatile long long sink=0; for(size_t i=0;i<M;++i) sink ^= A[idx[i]]; auto e=time_now();
+        perf_begin(); auto s=time_now(); volatile long long sink=0; for(size_t i=0;i<M;++i) sink ^= A[idx[i]]; auto e=time_now(); perf_end(result.perf);
+        result.ops_in_run=M; result.total_time_ns=dur_ns(s,e);
+    } else if (config.scenario == "READ_BATCH") {
+        std::fill(A.begin(), A.end(), 123);
+        size_t M = std::min((size_t)1e6, 10*config.N);
+        std::vector<size_t> idx(M); for(size_t i=0;i<M;++i) idx[i]=index_dist(rng);
+        std::vector<long long> out(M, 0);
+        perf_begin(); auto s=time_now();
+        for(size_t i=0;i<M;++i) out[i] = A[idx[i]];
+        auto e=time_now(); perf_end(result.perf);
+        volatile long long sink=0; for(size_t i=0;i<M;++i) sink ^= out[i];
         result.ops_in_run=M; result.total_time_ns=dur_ns(s,e);
     } else if (config.scenario == "WRITE_SEQUENTIAL") {
         std::fill(A.begin(), A.end(), 0);
-        auto s=time_now(); for (size_t i=0;i<config.N;++i) A[i]=i; auto e=time_now();
+        perf_begin(); auto s=time_now(); for (size_t i=0;i<config.N;++i) A[i]=i; auto e=time_now(); perf_end(result.perf);
         result.ops_in_run=config.N; result.total_time_ns=dur_ns(s,e);
     } else if (config.scenario == "WRITE_RANDOM") {
         std::fill(A.begin(), A.end(), 0);
         size_t M = std::min((size_t)1e6, config.N);
         std::vector<size_t> idx(M); for(size_t i=0;i<M;++i) idx[i]=index_dist(rng);
-        auto s=time_now(); for(size_t i=0;i<M;++i) A[idx[i]] = value_dist(rng); auto e=time_now();
+        perf_begin(); auto s=time_now(); for(size_t i=0;i<M;++i) A[idx[i]] = value_dist(rng); auto e=time_now(); perf_end(result.perf);
+        result.ops_in_run=M; result.total_time_ns=dur_ns(s,e);
+    } else if (config.scenario == "WRITE_RANGE") {
+        std::fill(A.begin(), A.end(), 0);
+        std::vector<long long> src(config.N); for(size_t i=0;i<config.N;++i) src[i]=(long long)i;
+        perf_begin(); auto s=time_now();
+        std::copy(src.begin(), src.end(), A.begin());
+        auto e=time_now(); perf_end(result.perf);
+        result.ops_in_run=config.N; result.total_time_ns=dur_ns(s,e);
+    } else if (config.scenario == "READ_RANGE") {
+        std::fill(A.begin(), A.end(), 123);
+        for(size_t i=0;i<config.N/2;++i) A[index_dist(rng)] = value_dist(rng);
+        std::vector<long long> dst(config.N, 0);
+        perf_begin(); auto s=time_now();
+        std::copy(A.begin(), A.end(), dst.begin());
+        auto e=time_now(); perf_end(result.perf);
+        volatile long long sink=0; for(size_t i=0;i<config.N;++i) sink ^= dst[i];
+        result.ops_in_run=config.N; result.total_time_ns=dur_ns(s,e);
+    } else if (config.scenario == "SCAN_SUM") {
+        for(size_t i=0;i<config.N;++i) A[i]=(long long)i;
+        size_t passes = std::max((size_t)1, (size_t)1e7 / config.N);
+        perf_begin(); auto s=time_now(); volatile long long sink=0;
+        for(size_t p=0;p<passes;++p) sink ^= simd_scan::sum(A.data(), config.N);
+        auto e=time_now(); perf_end(result.perf);
+        result.ops_in_run=passes*config.N; result.total_time_ns=dur_ns(s,e);
+    } else if (config.scenario == "MIXED_SATURATED") {
+        std::fill(A.begin(), A.end(), 42);
+        for(size_t i=0;i<config.N;++i) A[i]=(long long)i;
+        size_t M = std::min((size_t)5e6, 10*config.N);
+        std::vector<size_t> idx(M); for(size_t i=0;i<M;++i) idx[i]=index_dist(rng);
+        std::vector<uint8_t> ops(M); for(size_t i=0;i<M;++i) ops[i]=(rng()%100<50?0u:1u);
+        perf_begin(); auto s=time_now(); volatile long long sink=0;
+        for(size_t i=0;i<M;++i){ if(ops[i]==0) sink ^= A[idx[i]]; else A[idx[i]] = value_dist(rng); }
+        auto e=time_now(); perf_end(result.perf);
         result.ops_in_run=M; result.total_time_ns=dur_ns(s,e);
     } else if (config.scenario.rfind("MIXED_",0)==0) {
         std::fill(A.begin(), A.end(), 42);
@@ -276,18 +1614,86 @@ void run_scenario_direct_stdvector(const Config& config, Result& result) {
         int read_pct=std::stoi(perc.substr(rpos+1, wpos-rpos-1));
         size_t M = std::min((size_t)1e6, config.N);
         std::vector<size_t> idx(M); for(size_t i=0;i<M;++i) idx[i]=index_dist(rng);
-        std::vector<uint8_t> ops(M); for(size_t i=0;i<M;++i) ops[i]=(rng()%100<read_pct?0u:1u);
-        auto s=time_now(); volatile long long sink=0; 
+        std::vector<uint8_t> ops(M); for(size_t i=0;i<M;++i) ops[i]=(rng()%100<(unsigned)read_pct?0u:1u);
+        perf_begin(); auto s=time_now(); volatile long long sink=0; 
         for(size_t i=0;i<M;++i){ if(ops[i]==0) sink ^= A[idx[i]]; else A[idx[i]] = value_dist(rng); } 
-        auto e=time_now();
+        auto e=time_now(); perf_end(result.perf);
         result.ops_in_run=M; result.total_time_ns=dur_ns(s,e);
     } else if (config.scenario == "ADVERSARIAL_HOTSPOT") {
         std::fill(A.begin(), A.end(), 0);
         size_t M = std::min((size_t)1e6, config.N);
-        size_t hotspot = std::max((size_t)1, config.N/10);
-        auto s=time_now();
-        for(size_t i=0;i<M;++i){ size_t j = (rng()%2==0) ? (rng()%hotspot) : index_dist(rng); A[j]=value_dist(rng); }
-        auto e=time_now();
+        size_t hotspot = std::max((size_t)1, (size_t)((double)config.N * config.hotspot_frac));
+        perf_begin(); auto s=time_now();
+        for(size_t i=0;i<M;++i){ size_t j = (rng()%100 < (unsigned)config.hotspot_pct) ? (rng()%hotspot) : index_dist(rng); A[j]=value_dist(rng); }
+        auto e=time_now(); perf_end(result.perf);
+        result.ops_in_run=M; result.total_time_ns=dur_ns(s,e);
+    } else if (config.scenario.rfind("ZIPF_",0)==0) {
+        std::fill(A.begin(), A.end(), 0);
+        double zipf_theta = std::stod(config.scenario.substr(5));
+        ZipfianSampler zipf(config.N, zipf_theta);
+        size_t M = std::min((size_t)1e6, config.N);
+        std::vector<size_t> idx(M); for(size_t i=0;i<M;++i) idx[i]=zipf(rng);
+        perf_begin(); auto s=time_now(); for(size_t i=0;i<M;++i) A[idx[i]] = value_dist(rng); auto e=time_now(); perf_end(result.perf);
+        result.ops_in_run=M; result.total_time_ns=dur_ns(s,e);
+    } else if (config.scenario == "FILL_SWEEP") {
+        std::fill(A.begin(), A.end(), 0);
+        size_t M = config.N;
+        std::vector<size_t> marks;
+        for (double f = 0.01; f < 1.0; f *= 2) {
+            size_t m = (size_t)(f * (double)M);
+            if (m > 0 && (marks.empty() || m > marks.back())) marks.push_back(m);
+        }
+        if (marks.empty() || marks.back() != M) marks.push_back(M);
+        perf_begin(); auto s=time_now();
+        size_t done = 0;
+        for (size_t m : marks) {
+            for (; done < m; ++done) A[index_dist(rng)] = value_dist(rng);
+            result.fill_checkpoints.push_back({done, dur_ns(s, time_now()), Counters{}, 0, ""});
+        }
+        auto e=time_now(); perf_end(result.perf);
+        result.ops_in_run=M; result.total_time_ns=dur_ns(s,e);
+    } else if (config.scenario == "WORKLOAD") {
+        // Same pregenerated phase streams as run_scenario_direct, against
+        // the raw vector: init is a std::fill, reads and writes index A.
+        if (g_workload.empty()) throw std::invalid_argument("WORKLOAD requires --workload");
+        auto streams = build_workload_streams(config.N, rng);
+        std::fill(A.begin(), A.end(), 0);
+        size_t total_ops = 0;
+        perf_begin(); auto s=time_now(); volatile long long sink=0;
+        for (size_t p = 0; p < g_workload.size(); ++p) {
+            const auto& ph = g_workload[p];
+            auto p0 = time_now();
+            if (ph.is_init) {
+                std::fill(A.begin(), A.end(), ph.init_value);
+                total_ops += 1;
+                result.fill_checkpoints.push_back({1, dur_ns(p0, time_now()), Counters{}, 0, ph.label});
+                continue;
+            }
+            const auto& st = streams[p];
+            for (size_t i = 0; i < ph.ops; ++i) {
+                if (st.is_read[i]) sink ^= A[st.idx[i]];
+                else A[st.idx[i]] = value_dist(rng);
+            }
+            total_ops += ph.ops;
+            result.fill_checkpoints.push_back({ph.ops, dur_ns(p0, time_now()), Counters{}, 0, ph.label});
+        }
+        auto e=time_now(); perf_end(result.perf);
+        result.ops_in_run=total_ops; result.total_time_ns=dur_ns(s,e);
+    } else if (config.scenario == "TRACE_REPLAY") {
+        if (!g_trace_data) throw std::invalid_argument("TRACE_REPLAY requires --replay-trace");
+        const TraceRecord* ops = g_trace_data;
+        size_t M = g_trace_count;
+        perf_begin(); auto s=time_now(); volatile long long sink=0;
+        for (size_t i = 0; i < M; ++i) {
+            uint64_t oi = ops[i].op_index;
+            size_t idx = (size_t)(oi & kTraceIndexMask);
+            switch (oi >> kTraceOpShift) {
+                case kTraceRead:  sink ^= A[idx]; break;
+                case kTraceWrite: A[idx] = ops[i].value; break;
+                default:          std::fill(A.begin(), A.end(), ops[i].value); break;
+            }
+        }
+        auto e=time_now(); perf_end(result.perf);
         result.ops_in_run=M; result.total_time_ns=dur_ns(s,e);
     } else {
         throw std::invalid_argument("Unknown scenario: " + config.scenario);
@@ -296,26 +1702,227 @@ void run_scenario_direct_stdvector(const Config& config, Result& result) {
     result.counters = {};
 }
 
+// Embarrassingly-parallel scaling mode: T workers each drive a private
+// instance with a per-thread RNG seed. Aggregate throughput uses the slowest
+// worker's wall time; ns_per_op is the mean of the per-thread means.
+void run_scenario_threaded(const Config& config, size_t T, Result& result) {
+    std::vector<Result> partial(T);
+    std::vector<std::thread> workers;
+    workers.reserve(T);
+    for (size_t t = 0; t < T; ++t) {
+        workers.emplace_back([&config, &partial, t]{
+            Config c = config;
+            c.seed = config.seed + (unsigned)t * 1000003U;
+            c.latency_hist = false;   // per-thread histograms would need merging
+            try {
+                if (config.impl_name == "std_vector_direct") run_scenario_direct_stdvector(c, partial[t]);
+                else run_scenario_static(config.impl_name, c, partial[t]);
+            } catch (const std::exception&) {
+                partial[t].ops_in_run = 0;
+            }
+        });
+    }
+    for (auto& w : workers) w.join();
+
+    size_t ops = 0; long long max_ns = 0; double sum_nspo = 0.0; Counters agg{};
+    PerfEvents perf_agg;
+    for (const auto& r : partial) {
+        ops += r.ops_in_run;
+        max_ns = std::max(max_ns, r.total_time_ns);
+        sum_nspo += r.ns_per_op;
+        agg.relocations += r.counters.relocations;
+        agg.conversions += r.counters.conversions;
+        perf_agg.llc_misses += r.perf.llc_misses;
+        perf_agg.dtlb_misses += r.perf.dtlb_misses;
+        perf_agg.branch_misses += r.perf.branch_misses;
+        perf_agg.instructions += r.perf.instructions;
+    }
+    result.ops_in_run = ops;
+    result.total_time_ns = max_ns;
+    result.ns_per_op = sum_nspo / (double)T;
+    result.counters = agg;
+    result.perf = perf_agg;
+    result.threads = T;
+}
+
+// One measurement of config under the given dispatch mode (the per-rep unit
+// the sampling loop repeats). Returns false for impls with no mapping.
+bool run_single(const Config& config, const std::string& dispatch, Result& result) {
+    const size_t N = config.N;
+    if (config.impl_name == "std_vector_direct") {
+        result.dispatch = "static";
+        run_scenario_direct_stdvector(config, result);
+        return true;
+    }
+    // Scenarios built around class-specific machinery (save()/load(),
+    // ArrayPool) are static-only; a virtual pass maps to the same
+    // measurement.
+    if (config.scenario == "CHECKPOINT_RESTORE" || config.scenario == "POOL_CHURN") {
+        result.dispatch = "static";
+        return run_scenario_static(config.impl_name, config, result);
+    }
+    if (dispatch == "static") {
+        result.dispatch = "static";
+        return run_scenario_static(config.impl_name, config, result);
+    }
+    // For CONSTRUCT_AND_INIT the factory itself is part of the measurement
+    // (cold-start cost).
+    auto ctor_start = time_now();
+    std::unique_ptr<IInitializableArray> array_impl;
+    const std::string& impl_name = config.impl_name;
+    if (impl_name=="std_vector") array_impl = std::make_unique<StdVectorWrapper>(N);
+    const AllocMode am = alloc_mode_of(config);
+    if (impl_name=="sec3") array_impl = std::make_unique<InPlaceArraySec3>(N, am);
+    else if (impl_name=="sec4") array_impl = std::make_unique<InPlaceArraySec4>(N, am);
+    else if (impl_name=="sec3_i32") array_impl = std::make_unique<InPlaceArraySec3T<std::int32_t>>(N, am);
+    else if (impl_name=="sec4_i32") array_impl = std::make_unique<InPlaceArraySec4T<std::int32_t>>(N, am);
+    else if (impl_name=="sec3_i16") array_impl = std::make_unique<InPlaceArraySec3T<std::int16_t>>(N, am);
+    else if (impl_name=="sec4_i16") array_impl = std::make_unique<InPlaceArraySec4T<std::int16_t>>(N, am);
+    else if (impl_name=="sec3_raw") array_impl = std::make_unique<InPlaceArraySec3T<long long, StatsOff>>(N, am);
+    else if (impl_name=="sec4_raw") array_impl = std::make_unique<InPlaceArraySec4T<long long, StatsOff>>(N, am);
+    else if (impl_name=="sec4_c32") array_impl = std::make_unique<InPlaceArraySec4C32>(N, am);
+    else if (impl_name=="sec4_bf") array_impl = std::make_unique<InPlaceArraySec4BF>(N, am);
+    else if (impl_name=="blk8") array_impl = std::make_unique<InPlaceArrayBlocked<8>>(N, am);
+    else if (impl_name=="blk16") array_impl = std::make_unique<InPlaceArrayBlocked<16>>(N, am);
+    else if (impl_name=="epoch_stamp") array_impl = std::make_unique<EpochStampArray>(N);
+    else if (impl_name=="bitmap") array_impl = std::make_unique<BitmapArray>(N);
+    else if (impl_name=="adaptive") array_impl = std::make_unique<AdaptiveInitArray>(N);
+    else if (impl_name=="concurrent") array_impl = std::make_unique<ConcurrentInPlaceArray>(N);
+    if (!array_impl) return false;
+    if (config.scenario=="CONSTRUCT_AND_INIT") {
+        array_impl->init(42);
+        auto ctor_end = time_now();
+        result.ops_in_run = 1;
+        result.total_time_ns = duration_ns(ctor_start, ctor_end);
+        result.ns_per_op = (double)result.total_time_ns;
+        result.init_time_ns = result.total_time_ns;
+        result.counters = array_impl->get_counters();
+    } else {
+        run_scenario(*array_impl, config, result);
+    }
+    return true;
+}
+
+// Order-statistic summaries for the sampling loop. The stopping rule uses
+// the notched-boxplot approximation for the median's CI: 1.57*IQR/sqrt(n).
+double median_of(std::vector<double> v) {
+    std::sort(v.begin(), v.end());
+    size_t n = v.size();
+    return (v[(n-1)/2] + v[n/2]) / 2.0;
+}
+double mad_of(const std::vector<double>& v) {
+    double med = median_of(v);
+    std::vector<double> dev(v.size());
+    for (size_t i = 0; i < v.size(); ++i) dev[i] = std::abs(v[i] - med);
+    return median_of(dev);
+}
+double median_rci(std::vector<double> v) {
+    std::sort(v.begin(), v.end());
+    size_t n = v.size();
+    double med = (v[(n-1)/2] + v[n/2]) / 2.0;
+    double iqr = v[(3*n)/4] - v[n/4];
+    return med > 0.0 ? 1.57 * iqr / (std::sqrt((double)n) * med) : 0.0;
+}
+
+// Contended mode: T workers hammer ONE shared ConcurrentInPlaceArray with a
+// 90/10 read/write mix. Workers pre-generate their streams, then start on a
+// flag so the timed window only covers the contended ops.
+void run_shared_scenario(ConcurrentInPlaceArray& array, const Config& config, size_t T, Result& result) {
+    array.init(42);
+    array.reset_counters();
+    size_t M = std::min((size_t)1e6, config.N);
+    std::atomic<bool> go{false};
+    std::atomic<size_t> ready{0};
+    std::vector<std::thread> workers;
+    workers.reserve(T);
+    for (size_t t = 0; t < T; ++t) {
+        workers.emplace_back([&, t]{
+            std::mt19937 rng(config.seed + (unsigned)t * 1000003U);
+            std::uniform_int_distribution<size_t> index_dist(0, config.N - 1);
+            std::uniform_int_distribution<long long> value_dist(-1000, 1000);
+            std::vector<size_t> idx(M);
+            std::vector<uint8_t> ops(M);
+            for (size_t i = 0; i < M; ++i) { idx[i] = index_dist(rng); ops[i] = (rng()%100 < 90 ? 0u : 1u); }
+            ready.fetch_add(1);
+            while (!go.load(std::memory_order_acquire)) {}
+            volatile long long sink = 0;
+            for (size_t i = 0; i < M; ++i) {
+                if (ops[i]==0) sink ^= array.read(idx[i]);
+                else array.write(idx[i], value_dist(rng));
+            }
+        });
+    }
+    while (ready.load() < T) {}
+    auto start = time_now();
+    go.store(true, std::memory_order_release);
+    for (auto& w : workers) w.join();
+    auto end = time_now();
+    result.ops_in_run = M * T;
+    result.total_time_ns = duration_ns(start, end);
+    result.ns_per_op = (M > 0) ? (double)result.total_time_ns / (double)M : 0.0;  // per-thread
+    result.counters = array.get_counters();
+    result.threads = T;
+}
+
 int main(int argc, char* argv[]) {
     if (argc > 1 && std::string(argv[1]) == "--verify") {
         if (argc < 3) { print_usage(); return 1; }
         std::string impl_to_verify = argv[2];
-        size_t N = (argc > 3) ? std::stoull(argv[3]) : 10000ULL;
-        unsigned int seed = (argc > 4) ? std::stoul(argv[4]) : 42U;
+        size_t N = 10000ULL;
+        unsigned int seed = 42U;
+        int pos = 0;
+        for (int i = 3; i < argc; i++) {
+            std::string a = argv[i];
+            if (a == "--verify-ops" && i+1 < argc) { g_verify_ops = std::max(1, std::stoi(argv[++i])); }
+            else if (pos == 0) { N = std::stoull(a); pos++; }
+            else if (pos == 1) { seed = (unsigned)std::stoul(a); pos++; }
+        }
         try { verify_correctness(impl_to_verify, N, seed); } catch(const std::bad_alloc&){ std::cerr<<"Out of memory at N="<<N<<"\n"; }
         return 0;
     }
 
-    std::vector<std::string> impl_names = {"std_vector", "sec3", "sec4", "std_vector_direct"};
+    std::vector<std::string> impl_names = {"std_vector", "sec3", "sec4",
+                                           "sec3_i32", "sec4_i32", "sec3_i16", "sec4_i16",
+                                           "sec3_raw", "sec4_raw", "sec4_c32", "sec4_bf",
+                                           "blk8", "blk16",
+                                           "epoch_stamp", "bitmap", "adaptive", "concurrent",
+                                           "std_vector_direct"};
     std::vector<std::string> scenarios = {
-        "INIT_ONLY","READ_UNWRITTEN","WRITE_SEQUENTIAL","WRITE_RANDOM",
+        "INIT_ONLY","CONSTRUCT_AND_INIT","READ_UNWRITTEN","READ_BATCH","WRITE_SEQUENTIAL","WRITE_RANDOM",
+        "WRITE_RANGE","READ_RANGE","SCAN_SUM",
         "MIXED_R90W10","MIXED_R80W20","MIXED_R70W30","MIXED_R50W50","MIXED_R30W70","MIXED_R10W90",
-        "ADVERSARIAL_HOTSPOT"
+        "MIXED_SATURATED",
+        "CHECKPOINT_RESTORE",
+        "POOL_CHURN",
+        "ADVERSARIAL_HOTSPOT",
+        "ZIPF_0.99",
+        "FILL_SWEEP",
+        "SHARED_MIXED_R90W10"
     };
     std::vector<size_t> N_list = {10000ULL, 100000ULL, 1000000ULL};
     unsigned int seed = 42U;
     int reps = 3;
     std::string outfile = "results.csv";
+    std::vector<std::string> dispatch_modes = {"virtual", "static"};
+    size_t prefetch_dist = 8;
+    bool latency_hist = false;
+    std::string alloc = "malloc";
+    double hotspot_frac = 0.10;
+    int hotspot_pct = 50;
+    int warmup = 1;
+    double max_rci = 0.05;
+    int max_samples = 10;
+    std::string record_trace, replay_trace;
+    std::string trace_scenario = "MIXED_R90W10";
+    std::string workload_file;
+    std::string emit_streams_dir, conform_path;
+    std::string numa_arg = "none";
+    std::string format = "csv";
+    std::string convert_in, convert_out;
+    bool find_breakeven = false;
+    std::string breakeven_impl = "sec4";
+    std::string breakeven_scenario = "WRITE_RANDOM";
+    std::vector<size_t> threads_list = {1};
 
     for(int i=1;i<argc;++i){
         std::string a=argv[i];
@@ -327,47 +1934,266 @@ int main(int argc, char* argv[]) {
             std::stringstream ss(argv[++i]); std::string tok;
             while(std::getline(ss,tok,',')) if(!tok.empty()) impl_names.push_back(tok);
         } else if(a=="--outfile" && i+1<argc){ outfile = argv[++i]; }
+        else if(a=="--dispatch" && i+1<argc){
+            std::string d = argv[++i];
+            if(d=="virtual" || d=="static") dispatch_modes = {d};
+            else if(d=="both") dispatch_modes = {"virtual","static"};
+            else { std::cerr<<"Unknown --dispatch mode: "<<d<<"\n"; return 1; }
+        }
+        else if(a=="--prefetch-dist" && i+1<argc){ prefetch_dist = std::stoull(argv[++i]); }
+        else if(a=="--latency-hist"){ latency_hist = true; }
+        else if(a=="--warmup" && i+1<argc){ warmup = std::stoi(argv[++i]); }
+        else if(a=="--max-rci" && i+1<argc){ max_rci = std::stod(argv[++i]); }
+        else if(a=="--max-samples" && i+1<argc){ max_samples = std::max(1, std::stoi(argv[++i])); }
+        else if(a=="--find-breakeven"){ find_breakeven = true; }
+        else if(a=="--breakeven-impl" && i+1<argc){ breakeven_impl = argv[++i]; }
+        else if(a=="--breakeven-scenario" && i+1<argc){ breakeven_scenario = argv[++i]; }
+        else if(a=="--record-trace" && i+1<argc){ record_trace = argv[++i]; }
+        else if(a=="--replay-trace" && i+1<argc){ replay_trace = argv[++i]; }
+        else if(a=="--trace-scenario" && i+1<argc){ trace_scenario = argv[++i]; }
+        else if(a=="--workload" && i+1<argc){ workload_file = argv[++i]; }
+        else if(a=="--emit-streams" && i+1<argc){ emit_streams_dir = argv[++i]; }
+        else if(a=="--conform" && i+1<argc){ conform_path = argv[++i]; }
+        else if(a=="--hotspot-frac" && i+1<argc){ hotspot_frac = std::stod(argv[++i]); }
+        else if(a=="--hotspot-pct" && i+1<argc){ hotspot_pct = std::stoi(argv[++i]); }
+        else if(a=="--perf"){
+#if defined(__linux__)
+            g_perf_requested = true;
+#else
+            std::cerr<<"warning: --perf requires Linux perf_event; ignored\n";
+#endif
+        }
+        else if(a=="--alloc" && i+1<argc){
+            alloc = argv[++i];
+            if(alloc!="malloc" && alloc!="hugepage"){ std::cerr<<"Unknown --alloc mode: "<<alloc<<"\n"; return 1; }
+        }
+        else if(a=="--numa" && i+1<argc){ numa_arg = argv[++i]; }
+        else if(a=="--format" && i+1<argc){
+            format = argv[++i];
+            if(format!="csv" && format!="bin"){ std::cerr<<"Unknown --format: "<<format<<"\n"; return 1; }
+        }
+        else if(a=="--convert-results" && i+2<argc){ convert_in = argv[++i]; convert_out = argv[++i]; }
+        else if(a=="--threads" && i+1<argc){
+            std::string t = argv[++i];
+            if(t=="sweep"){
+                threads_list.clear();
+                size_t hw = std::max(1u, std::thread::hardware_concurrency());
+                for(size_t T=1; T<=hw; T*=2) threads_list.push_back(T);
+                if(threads_list.back()!=hw) threads_list.push_back(hw);
+            } else {
+                threads_list = parse_sizes(t);
+            }
+        }
         else if(a=="--help" || a=="-h"){ print_usage(); return 0; }
     }
 
-    std::ofstream csv_file(outfile);
-    if (!csv_file.is_open()) { std::cerr<<"Error: cannot open "<<outfile<<"\n"; return 1; }
-    write_csv_header(csv_file);
+    if (!convert_in.empty()) return convert_results(convert_in, convert_out);
+
+    // Install the NUMA policy before the first backing array is allocated;
+    // pages fault in under whatever policy is current, so later would be
+    // too late for the early rows.
+    std::string numa_label = "none";
+    {
+        NumaMode numa_mode = NumaMode::None; int numa_node = 0;
+        if (numa_arg == "interleave") { numa_mode = NumaMode::Interleave; numa_label = "interleave"; }
+        else if (numa_arg.rfind("bind:", 0) == 0) {
+            numa_mode = NumaMode::Bind;
+            numa_node = std::stoi(numa_arg.substr(5));
+            numa_label = "bind:" + std::to_string(numa_node);
+        } else if (numa_arg != "none") {
+            std::cerr << "Unknown --numa policy: " << numa_arg << "\n"; return 1;
+        }
+        std::string err;
+        if (!apply_numa_policy(numa_mode, numa_node, err)) {
+            std::cerr << "warning: --numa " << numa_arg << " not applied (" << err
+                      << "); keeping first-touch placement\n";
+            numa_label = "none";
+        }
+    }
+
+    if (find_breakeven) {
+        try {
+            return run_breakeven(breakeven_impl, breakeven_scenario,
+                                 N_list.front(), N_list.back(), seed, alloc);
+        } catch (const std::exception& e) {
+            std::cerr << "break-even search failed: " << e.what() << "\n"; return 1;
+        }
+    }
+    if (!record_trace.empty()) {
+        // Capture-only mode: dump the op stream the scenario would issue at
+        // the first N of the sweep, then exit. Replay with --replay-trace.
+        try {
+            size_t N = N_list.front();
+            auto ops = generate_trace(trace_scenario, N, seed, hotspot_frac, hotspot_pct);
+            write_trace(record_trace, N, ops);
+            std::cout << "Recorded " << ops.size() << " ops (" << trace_scenario
+                      << ", N=" << N << ", seed=" << seed << ") to " << record_trace << "\n";
+            return 0;
+        } catch (const std::exception& e) {
+            std::cerr << "trace capture failed: " << e.what() << "\n"; return 1;
+        }
+    }
+    if (!emit_streams_dir.empty()) {
+        // Canonical stream capture for the cross-language sweep: one trace
+        // per traceable scenario and N, named so the other harnesses and
+        // sweep.py can find them. This harness is the source of truth; the
+        // Go/Python/Rust harnesses replay these files bit-identically.
+        std::vector<std::string> capture = {
+            "READ_UNWRITTEN","WRITE_RANDOM",
+            "MIXED_R90W10","MIXED_R80W20","MIXED_R70W30","MIXED_R50W50","MIXED_R30W70","MIXED_R10W90",
+            "ADVERSARIAL_HOTSPOT","ZIPF_0.99"};
+        try {
+            for (size_t N : N_list) {
+                for (const auto& sc : capture) {
+                    auto ops = generate_trace(sc, N, seed, hotspot_frac, hotspot_pct);
+                    std::string p = emit_streams_dir + "/" + sc + "_N" + std::to_string(N)
+                                  + "_seed" + std::to_string(seed) + ".ipbt";
+                    write_trace(p, N, ops);
+                    std::cout << "Emitted " << ops.size() << " ops to " << p << "\n";
+                }
+            }
+        } catch (const std::exception& e) {
+            std::cerr << "stream capture failed: " << e.what() << "\n"; return 1;
+        }
+        return 0;
+    }
+    if (!replay_trace.empty()) {
+        try {
+            load_trace(replay_trace);
+        } catch (const std::exception& e) {
+            std::cerr << "trace load failed: " << e.what() << "\n"; return 1;
+        }
+        std::cout << "Replaying " << g_trace_count << " ops (trace N=" << g_trace_N
+                  << ") from " << replay_trace << "\n";
+        scenarios = {"TRACE_REPLAY"};
+        N_list = {g_trace_N};
+    }
+    // --conform runs after a possible --replay-trace load so TRACE_REPLAY
+    // rows can be checked against the trace's own op count.
+    if (!conform_path.empty()) return conform_results(conform_path);
+    if (!workload_file.empty()) {
+        try {
+            load_workload(workload_file);
+        } catch (const std::exception& e) {
+            std::cerr << "workload load failed: " << e.what() << "\n"; return 1;
+        }
+        std::cout << "Workload: " << g_workload.size() << " phases from " << workload_file << "\n";
+        scenarios = {"WORKLOAD"};
+    }
+
+    ResultSink sink(outfile, format == "bin");
+    if (!sink.ok()) { std::cerr<<"Error: cannot open "<<outfile<<"\n"; return 1; }
 
     for(const auto& impl_name : impl_names){
         for(const auto& N : N_list){
-            if ((impl_name == "sec3" && N % 2 != 0) || (impl_name == "sec4" && N % 4 != 0)) continue;
+            if ((impl_name.rfind("sec3",0)==0 && N % 2 != 0) || (impl_name.rfind("sec4",0)==0 && N % 4 != 0)) continue;
+            if ((impl_name=="adaptive" || impl_name=="concurrent") && N % 4 != 0) continue;
+            if (impl_name.rfind("blk",0)==0 && N % std::stoull(impl_name.substr(3)) != 0) continue;
+            // Narrow value types cannot encode chain pointers past their max index.
+            if (impl_name.find("_i16") != std::string::npos && N-1 > (size_t)std::numeric_limits<std::int16_t>::max()) continue;
+            if (impl_name.find("_i32") != std::string::npos && N-1 > (size_t)std::numeric_limits<std::int32_t>::max()) continue;
+            if (impl_name.find("_c32") != std::string::npos && N-1 > (size_t)std::numeric_limits<std::int32_t>::max()) continue;
             for(const auto& scenario : scenarios){
+                // The shared-instance scenario only makes sense for the
+                // thread-safe impl; everything else would race.
+                if (scenario=="SHARED_MIXED_R90W10" && impl_name!="concurrent") continue;
+                // Checkpointing exists only on the in-place classes.
+                if (scenario=="CHECKPOINT_RESTORE" && !(impl_name.rfind("sec3",0)==0 || impl_name.rfind("sec4",0)==0)) continue;
+                // std_vector_direct has no class to pool.
+                if (scenario=="POOL_CHURN" && impl_name=="std_vector_direct") continue;
                 for(int rep=1; rep<=reps; ++rep){
-                    Config config{impl_name, scenario, N, seed, rep};
-                    std::cout<<"Running: "<<impl_name<<" "<<scenario<<" N="<<N<<" seed="<<seed<<" rep="<<rep<<"...\n";
+                    for(size_t T : threads_list){
+                    for(const auto& dispatch : dispatch_modes){
+                    // std_vector_direct is raw loops: no dispatch at all. Run
+                    // it once per rep and label it static. Threaded workers
+                    // are monomorphized, so they are static-only too.
+                    if((impl_name=="std_vector_direct" || T>1 || scenario=="SHARED_MIXED_R90W10" || scenario=="CHECKPOINT_RESTORE" || scenario=="POOL_CHURN") && dispatch=="virtual" && dispatch_modes.size()>1) continue;
+                    Config config{impl_name, scenario, N, seed, rep, prefetch_dist, latency_hist, alloc, hotspot_frac, hotspot_pct};
+                    std::cout<<"Running: "<<impl_name<<" "<<scenario<<" N="<<N<<" seed="<<seed<<" rep="<<rep<<" dispatch="<<dispatch<<(T>1?" threads="+std::to_string(T):"")<<"...\n";
                     try {
                         Result result;
                         result.timestamp_iso = get_current_timestamp();
                         result.impl_name = impl_name; result.scenario = scenario; result.N=N; result.seed=seed; result.rep_id=rep;
-                        if(impl_name=="std_vector_direct"){
-                            run_scenario_direct_stdvector(config, result);
+                        result.dispatch = dispatch;
+                        result.alloc = alloc;
+                        result.numa = numa_label;
+                        if(scenario=="SHARED_MIXED_R90W10"){
+                            result.dispatch = "static";
+                            ConcurrentInPlaceArray shared(N);
+                            run_shared_scenario(shared, config, T, result);
+                        }else if(T>1){
+                            result.dispatch = "static";
+                            run_scenario_threaded(config, T, result);
                         }else{
-                            std::unique_ptr<IInitializableArray> array_impl;
-                            if (impl_name=="std_vector") array_impl = std::make_unique<StdVectorWrapper>(N);
-                            else if (impl_name=="sec3") array_impl = std::make_unique<InPlaceArraySec3>(N);
-                            else if (impl_name=="sec4") array_impl = std::make_unique<InPlaceArraySec4>(N);
-                            if (!array_impl) continue;
-                            run_scenario(*array_impl, config, result);
+                            // Robust measurement: warmup runs soak up cold
+                            // caches and frequency scaling, then samples
+                            // accrue until the median's CI is below max_rci
+                            // (or the cap); the row reports their spread.
+                            // FILL_SWEEP is one pass by construction, and
+                            // warming up CONSTRUCT_AND_INIT would defeat a
+                            // cold-start measurement.
+                            int warm = (scenario=="CONSTRUCT_AND_INIT" || scenario=="FILL_SWEEP" || scenario=="CHECKPOINT_RESTORE" || scenario=="POOL_CHURN" || scenario=="WORKLOAD") ? 0 : warmup;
+                            bool mapped = true;
+                            for (int w = 0; w < warm && mapped; ++w) {
+                                Result tmp = result;
+                                mapped = run_single(config, dispatch, tmp);
+                            }
+                            std::vector<double> samp;
+                            Result last = result;
+                            while (mapped) {
+                                Result s = result;
+                                if (!(mapped = run_single(config, dispatch, s))) break;
+                                samp.push_back(s.ns_per_op);
+                                last = s;
+                                if (!s.fill_checkpoints.empty()) break;  // per-phase/checkpoint rows: one run
+                                if (samp.size() >= 3 && median_rci(samp) <= max_rci) break;
+                                if (samp.size() >= (size_t)max_samples) break;
+                            }
+                            if (!mapped) continue;
+                            result = last;
+                            result.ns_per_op = std::accumulate(samp.begin(), samp.end(), 0.0) / (double)samp.size();
+                            result.min_ns_per_op = *std::min_element(samp.begin(), samp.end());
+                            result.median_ns_per_op = median_of(samp);
+                            result.mad_ns_per_op = mad_of(samp);
+                            result.samples = samp.size();
+                        }
+                        if (result.samples <= 1 && result.min_ns_per_op == 0.0) {
+                            result.min_ns_per_op = result.ns_per_op;
+                            result.median_ns_per_op = result.ns_per_op;
+                        }
+                        if (!result.fill_checkpoints.empty()) {
+                            // FILL_SWEEP: one row per checkpoint; the last
+                            // checkpoint doubles as the end-of-run row.
+                            for (const auto& cp : result.fill_checkpoints) {
+                                Result row = result;
+                                row.fill_checkpoints.clear();
+                                row.ops_in_run = cp.writes_done;
+                                row.total_time_ns = cp.elapsed_ns;
+                                row.ns_per_op = cp.writes_done ? (double)cp.elapsed_ns/(double)cp.writes_done : 0.0;
+                                row.counters = cp.counters;
+                                row.written_blocks = cp.written_blocks;
+                                if (!cp.label.empty()) row.scenario = cp.label;
+                                sink.write(row);
+                            }
+                        } else {
+                            sink.write(result);
                         }
-                        write_csv_row(csv_file, result);
-                        csv_file.flush();
                     } catch(const std::bad_alloc&){
                         std::cerr<<"Out of memory at N="<<N<<". Skipping.\n";
                     } catch(const std::exception& e){
                         std::cerr<<" ERROR: "<<e.what()<<"\n";
                     }
+                    }
+                    }
                 }
             }
         }
     }
 
+    sink.finish();
     std::cout<<"\nExperiment suite finished. Results saved to "<<outfile<<"\n";
+    if (format == "bin")
+        std::cout<<"Convert for analysis: ./benchmark --convert-results "<<outfile<<" results.csv\n";
     std::cout<<"To run the correctness checker: ./benchmark --verify <sec3|sec4> [N] [seed]\n";
     return 0;
 }
@@ -2,7 +2,8 @@
 # Writes python-results.csv.
 # Usage:
 #   python py_benchmark.py --Ns 10000,100000,1000000 --reps 3 --seed 42 --outfile python-results.csv
-import csv, time, random, argparse
+#   python py_benchmark.py --replay-trace streams/MIXED_R50W50_N100000_seed42.ipbt --outfile python-results.csv
+import csv, time, random, argparse, struct
 try:
     import numpy as np
 except Exception:
@@ -62,7 +63,7 @@ def run_scenario(arr: ArrayImpl, scenario: str, N: int, seed: int):
 
     if scenario == "INIT_ONLY":
         t0 = time.perf_counter_ns(); arr.init(42); t1 = time.perf_counter_ns()
-        return 1, (t1 - t0), 0.0, (t1 - t0)
+        return 1, (t1 - t0), float(t1 - t0), (t1 - t0)
     elif scenario == "READ_UNWRITTEN":
         arr.init(123); M = min(int(1e6), 10*N); idx = mk_indices(M)
         t0 = time.perf_counter_ns(); acc = 0
@@ -98,12 +99,41 @@ def run_scenario(arr: ArrayImpl, scenario: str, N: int, seed: int):
     else:
         raise ValueError("unknown scenario: " + scenario)
 
+# Canonical stream files emitted by the C++ harness (--emit-streams): IPBT v1,
+# 24-byte header then 16-byte (op_index, value) records; the op lives in the
+# top 2 bits of op_index (0=read, 1=write, 2=init), the index in the low 62.
+TRACE_INDEX_MASK = (1 << 62) - 1
+
+def load_trace(path):
+    with open(path, "rb") as f:
+        data = f.read()
+    magic, version, N, count = struct.unpack_from("<4sIQQ", data, 0)
+    if magic != b"IPBT" or version != 1:
+        raise ValueError("not a v1 trace file: " + path)
+    if len(data) < 24 + 16*count:
+        raise ValueError("trace file truncated: " + path)
+    ops = list(struct.iter_unpack("<Qq", data[24:24 + 16*count]))
+    return N, ops
+
+def run_trace(arr: ArrayImpl, ops):
+    t0 = time.perf_counter_ns(); acc = 0
+    for op_index, value in ops:
+        op = op_index >> 62
+        i = op_index & TRACE_INDEX_MASK
+        if op == 0: acc ^= arr.read(i)
+        elif op == 1: arr.write(i, value)
+        else: arr.init(value)
+    t1 = time.perf_counter_ns(); _sink = acc
+    m = len(ops)
+    return m, (t1 - t0), (t1 - t0) / m, 0
+
 def main():
     ap = argparse.ArgumentParser()
     ap.add_argument("--Ns", default="10000,100000,1000000")
     ap.add_argument("--reps", type=int, default=3)
     ap.add_argument("--seed", type=int, default=42)
     ap.add_argument("--outfile", default="python-results.csv")
+    ap.add_argument("--replay-trace", default="")
     args = ap.parse_args()
 
     N_list = [int(x) for x in args.Ns.split(",") if x]
@@ -116,6 +146,13 @@ def main():
     ]
     impl_classes = [PyListImpl, PyArrayImpl] + ([NumpyImpl] if np is not None else [])
 
+    trace_ops = None
+    if args.replay_trace:
+        trace_N, trace_ops = load_trace(args.replay_trace)
+        print(f"Replaying {len(trace_ops)} ops (trace N={trace_N}) from {args.replay_trace}")
+        N_list = [trace_N]
+        scenarios = ["TRACE_REPLAY"]
+
     with open(args.outfile, "w", newline="", encoding="utf-8") as f:
         w = csv.writer(f); w.writerow(HEADER)
         for N in N_list:
@@ -123,7 +160,10 @@ def main():
                 for scenario in scenarios:
                     for rep in range(1, reps+1):
                         arr = Impl(N)
-                        ops, total_ns, nspop, init_ns = run_scenario(arr, scenario, N, args.seed)
+                        if trace_ops is not None:
+                            ops, total_ns, nspop, init_ns = run_trace(arr, trace_ops)
+                        else:
+                            ops, total_ns, nspop, init_ns = run_scenario(arr, scenario, N, args.seed)
                         w.writerow([now_iso(), arr.name(), scenario, N, args.seed, rep,
                                     ops, total_ns, f"{nspop:.4f}", init_ns, 0, 0])
                         f.flush()
@@ -1,6 +1,7 @@
 // rust_benchmark/src/main.rs
 // Usage:
 //   cargo run --release --manifest-path rust_benchmark/Cargo.toml -- --Ns 1k,10k,100k,1m,10m,100m --reps 3 --seed 42 --outfile rust-results.csv
+//   cargo run --release --manifest-path rust_benchmark/Cargo.toml -- --replay-trace streams/MIXED_R50W50_N100000_seed42.ipbt --outfile rust-results.csv
 
 use chrono::Utc;
 use csv::Writer;
@@ -59,7 +60,7 @@ fn run_scenario(arr: &mut dyn ArrayImpl, scenario: &str, n: usize, seed: u64) ->
             let t0 = Instant::now();
             arr.init(42);
             let el = t0.elapsed().as_nanos() as i64;
-            (1, el, 0.0, el)
+            (1, el, el as f64, el)
         }
         "READ_UNWRITTEN" => {
             arr.init(123);
@@ -125,11 +126,52 @@ fn run_scenario(arr: &mut dyn ArrayImpl, scenario: &str, n: usize, seed: u64) ->
     }
 }
 
+// Canonical stream files emitted by the C++ harness (--emit-streams): IPBT
+// v1, 24-byte header then 16-byte (op_index, value) records; the op lives in
+// the top 2 bits of op_index (0=read, 1=write, 2=init), the index in the
+// low 62.
+const TRACE_INDEX_MASK: u64 = (1u64 << 62) - 1;
+
+fn load_trace(path: &str) -> (usize, Vec<(u64, i64)>) {
+    let data = std::fs::read(path).expect("cannot open trace file");
+    if data.len() < 24 || &data[..4] != b"IPBT"
+        || u32::from_le_bytes(data[4..8].try_into().unwrap()) != 1 {
+        panic!("not a v1 trace file: {}", path);
+    }
+    let n = u64::from_le_bytes(data[8..16].try_into().unwrap()) as usize;
+    let count = u64::from_le_bytes(data[16..24].try_into().unwrap()) as usize;
+    if data.len() < 24 + 16*count { panic!("trace file truncated: {}", path); }
+    let ops = (0..count).map(|i| {
+        let off = 24 + 16*i;
+        (u64::from_le_bytes(data[off..off+8].try_into().unwrap()),
+         i64::from_le_bytes(data[off+8..off+16].try_into().unwrap()))
+    }).collect();
+    (n, ops)
+}
+
+fn run_trace(arr: &mut dyn ArrayImpl, ops: &[(u64, i64)]) -> (usize, i64, f64, i64) {
+    let t0 = Instant::now();
+    let mut s: i64 = 0;
+    for &(op_index, value) in ops {
+        let i = (op_index & TRACE_INDEX_MASK) as usize;
+        match op_index >> 62 {
+            0 => s ^= arr.read(black_box(i)),
+            1 => arr.write(black_box(i), value),
+            _ => { arr.init(value); }
+        }
+    }
+    let el = t0.elapsed().as_nanos() as i64;
+    black_box(s);
+    let m = ops.len();
+    (m, el, el as f64 / m as f64, 0)
+}
+
 fn main() -> Result<(), Box<dyn std::error::Error>> {
     let mut Ns = String::from("10000,100000,1000000");
     let mut reps: usize = 3;
     let mut seed: u64 = 42;
     let mut outfile = String::from("rust-results.csv");
+    let mut replay_trace = String::new();
 
     let mut args = env::args().skip(1);
     while let Some(a) = args.next() {
@@ -138,6 +180,7 @@ fn main() -> Result<(), Box<dyn std::error::Error>> {
             "--reps" => if let Some(v) = args.next() { reps = v.parse().unwrap_or(3) },
             "--seed" => if let Some(v) = args.next() { seed = v.parse().unwrap_or(42) },
             "--outfile" => if let Some(v) = args.next() { outfile = v },
+            "--replay-trace" => if let Some(v) = args.next() { replay_trace = v },
             _ => {},
         }
     }
@@ -149,23 +192,35 @@ fn main() -> Result<(), Box<dyn std::error::Error>> {
         "relocations_count","conversions_count",
     ])?;
 
-    let n_list = {
+    let mut n_list = {
         let v = parse_sizes(&Ns);
         if v.is_empty() { vec![10_000usize, 100_000, 1_000_000] } else { v }
     };
     let seeds = vec![seed];
-    let scenarios = vec![
+    let mut scenarios = vec![
         "INIT_ONLY","READ_UNWRITTEN","WRITE_SEQUENTIAL","WRITE_RANDOM",
         "MIXED_R90W10","MIXED_R80W20","MIXED_R70W30","MIXED_R50W50","MIXED_R30W70","MIXED_R10W90",
         "ADVERSARIAL_HOTSPOT",
     ];
 
+    let mut trace_ops: Option<Vec<(u64, i64)>> = None;
+    if !replay_trace.is_empty() {
+        let (trace_n, ops) = load_trace(&replay_trace);
+        println!("Replaying {} ops (trace N={}) from {}", ops.len(), trace_n, replay_trace);
+        n_list = vec![trace_n];
+        scenarios = vec!["TRACE_REPLAY"];
+        trace_ops = Some(ops);
+    }
+
     for &n in &n_list {
         for s in &scenarios {
             for &seed in &seeds {
                 for rep in 1..=reps {
                     let mut arr = VecImpl::new(n);
-                    let (ops, tot, nspop, initns) = run_scenario(&mut arr, s, n, seed);
+                    let (ops, tot, nspop, initns) = match &trace_ops {
+                        Some(t) => run_trace(&mut arr, t),
+                        None => run_scenario(&mut arr, s, n, seed),
+                    };
                     wtr.write_record(&[
                         now_iso(), arr.name().to_string(), s.to_string(),
                         format!("{}", n), format!("{}", seed), format!("{}", rep),
@@ -0,0 +1,89 @@
+# sweep.py — unified cross-language sweep with shared workload streams.
+# The C++ harness is the source of truth: it emits canonical .ipbt stream
+# files (--emit-streams), each language harness replays them bit-identically
+# (--replay-trace), and every CSV is conformance-checked against the C++
+# schema and op counts (--conform). Writes results.csv, go-results.csv,
+# python-results.csv and rust-results.csv into --outdir, ready for
+# analyze_results.py.
+# Usage:
+#   python sweep.py --Ns 10000,100000,1000000 --reps 3 --seed 42 --outdir sweep_out
+#   python sweep.py --skip go,rust          # toolchains you don't have
+import argparse, glob, os, shutil, subprocess, sys
+
+HARNESSES = {
+    "cpp":    lambda s, reps, out: ["./benchmark", "--replay-trace", s,
+                                    "--reps", str(reps), "--impls", "std_vector,sec3,sec4",
+                                    "--dispatch", "static", "--outfile", out],
+    "python": lambda s, reps, out: [sys.executable, "py_benchmark.py", "--replay-trace", s,
+                                    "--reps", str(reps), "--outfile", out],
+    "go":     lambda s, reps, out: ["go", "run", "go_benchmark.go", "-replay-trace", s,
+                                    "-reps", str(reps), "-outfile", out],
+    "rust":   lambda s, reps, out: ["cargo", "run", "--release", "--quiet",
+                                    "--manifest-path", "rust_benchmark/Cargo.toml", "--",
+                                    "--replay-trace", s, "--reps", str(reps), "--outfile", out],
+}
+OUTFILE = {"cpp": "results.csv", "python": "python-results.csv",
+           "go": "go-results.csv", "rust": "rust-results.csv"}
+
+def run(cmd):
+    print("+", " ".join(cmd), flush=True)
+    subprocess.run(cmd, check=True)
+
+def concat_csvs(parts, out):
+    with open(out, "w", newline="", encoding="utf-8") as f:
+        for k, part in enumerate(parts):
+            with open(part, encoding="utf-8") as p:
+                lines = p.readlines()
+            f.writelines(lines if k == 0 else lines[1:])
+
+def main():
+    ap = argparse.ArgumentParser()
+    ap.add_argument("--Ns", default="10000,100000,1000000")
+    ap.add_argument("--reps", type=int, default=3)
+    ap.add_argument("--seed", type=int, default=42)
+    ap.add_argument("--outdir", default="sweep_out")
+    ap.add_argument("--skip", default="", help="comma-separated harnesses to skip (cpp,python,go,rust)")
+    args = ap.parse_args()
+
+    if not os.path.exists("./benchmark"):
+        sys.exit("sweep: ./benchmark not found; build it first "
+                 "(g++ -O3 -std=c++17 -DNDEBUG -pthread main.cpp -o benchmark)")
+    skip = {t for t in args.skip.split(",") if t}
+    for name, tool in [("go", "go"), ("rust", "cargo")]:
+        if name not in skip and shutil.which(tool) is None:
+            print(f"sweep: {tool} not on PATH; skipping {name}")
+            skip.add(name)
+
+    streams_dir = os.path.join(args.outdir, "streams")
+    os.makedirs(streams_dir, exist_ok=True)
+    run(["./benchmark", "--emit-streams", streams_dir,
+         "--Ns", args.Ns, "--seed", str(args.seed)])
+    streams = sorted(glob.glob(os.path.join(streams_dir, "*.ipbt")))
+    if not streams:
+        sys.exit("sweep: no streams emitted")
+
+    failures = []
+    for harness, cmdline in HARNESSES.items():
+        if harness in skip:
+            continue
+        parts = []
+        for s in streams:
+            part = os.path.join(args.outdir, harness + "." + os.path.basename(s) + ".csv")
+            run(cmdline(s, args.reps, part))
+            # Conformance gate: schema and op counts against the C++ harness,
+            # with the trace loaded so TRACE_REPLAY rows check its op count.
+            rc = subprocess.run(["./benchmark", "--replay-trace", s, "--conform", part]).returncode
+            if rc != 0:
+                failures.append(part)
+            parts.append(part)
+        concat_csvs(parts, os.path.join(args.outdir, OUTFILE[harness]))
+        for part in parts:
+            os.remove(part)
+
+    if failures:
+        sys.exit("sweep: conformance FAILED for: " + ", ".join(failures))
+    print(f"sweep: done; merged CSVs in {args.outdir}/ "
+          "(point analyze_results.py at them for apples-to-apples plots)")
+
+if __name__ == "__main__":
+    main()